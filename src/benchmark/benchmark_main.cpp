@@ -0,0 +1,97 @@
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark_runner.hpp"
+#include "benchmarks.hpp"
+#include "utils/performance_warning.hpp"
+
+namespace {
+
+void print_usage(const std::map<std::string, std::function<void(opossum::BenchmarkRunner&)>>& groups) {
+  std::cerr << "Usage: hyriseBenchmark [options] [group...]\n"
+            << "Runs the given groups of benchmarks, or all of them, and writes the results as JSON.\n\n"
+            << "Options:\n"
+            << "  --rows=N          number of rows of the generated tables\n"
+            << "  --chunk-size=N    chunk size of the generated tables\n"
+            << "  --repetitions=N   measured runs per benchmark, after one warm-up run\n"
+            << "  --output=FILE     write the JSON results to FILE instead of stdout\n\n"
+            << "Groups:\n";
+  for (const auto& group : groups) std::cerr << "  " << group.first << "\n";
+}
+
+// Parses a non-negative number that makes up the whole value
+bool parse_count(const std::string& value, size_t& count) {
+  if (value.empty() || !std::isdigit(static_cast<unsigned char>(value.front()))) return false;
+  try {
+    auto parsed_length = size_t{0};
+    count = std::stoull(value, &parsed_length);
+    return parsed_length == value.size();
+  } catch (const std::logic_error&) {
+    // std::invalid_argument or std::out_of_range
+    return false;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  // The progress is written to stderr and the results to stdout, which performance warnings would spoil
+  PerformanceWarningDisabler performance_warning_disabler;
+
+  const auto groups = std::map<std::string, std::function<void(opossum::BenchmarkRunner&)>>{
+      {"DictionarySegment", opossum::run_dictionary_segment_benchmarks},
+      {"LoadTable", opossum::run_load_table_benchmarks},
+      {"ReferenceSegment", opossum::run_reference_segment_benchmarks},
+      {"ScanKernels", opossum::run_scan_kernels_benchmarks},
+      {"TableScan", opossum::run_table_scan_benchmarks}};
+
+  auto config = opossum::BenchmarkConfig{};
+  auto output_file_name = std::string{};
+  auto selected_groups = std::vector<std::string>{};
+  for (auto argument_index = 1; argument_index < argc; ++argument_index) {
+    const auto argument = std::string{argv[argument_index]};
+    const auto value = argument.substr(argument.find('=') + 1);
+    auto valid_argument = true;
+    if (argument.rfind("--rows=", 0) == 0) {
+      valid_argument = parse_count(value, config.row_count);
+    } else if (argument.rfind("--chunk-size=", 0) == 0) {
+      valid_argument = parse_count(value, config.chunk_size);
+    } else if (argument.rfind("--repetitions=", 0) == 0) {
+      valid_argument = parse_count(value, config.repetitions);
+    } else if (argument.rfind("--output=", 0) == 0) {
+      output_file_name = value;
+    } else if (groups.count(argument)) {
+      selected_groups.emplace_back(argument);
+    } else {
+      valid_argument = false;
+    }
+
+    if (!valid_argument) {
+      print_usage(groups);
+      return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+  if (selected_groups.empty()) {
+    for (const auto& group : groups) selected_groups.emplace_back(group.first);
+  }
+
+  if (IS_DEBUG) std::cerr << "Warning: This is a debug build, whose results are not meaningful\n";
+
+  auto runner = opossum::BenchmarkRunner{config};
+  for (const auto& group : selected_groups) groups.at(group)(runner);
+
+  if (output_file_name.empty()) {
+    runner.write_json(std::cout);
+  } else {
+    auto file = std::ofstream{output_file_name};
+    runner.write_json(file);
+  }
+  return EXIT_SUCCESS;
+}
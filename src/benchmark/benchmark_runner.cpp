@@ -0,0 +1,115 @@
+#include "benchmark_runner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opossum {
+
+namespace {
+
+std::string escape_json(const std::string& string) {
+  auto escaped = std::ostringstream{};
+  for (const auto character : string) {
+    if (character == '"' || character == '\\') {
+      escaped << '\\' << character;
+    } else if (static_cast<unsigned char>(character) < 0x20) {
+      escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(character) << std::dec;
+    } else {
+      escaped << character;
+    }
+  }
+  return escaped.str();
+}
+
+// e.g., "TableScan/encoding=Dictionary/scan_type=<", which identifies a benchmark across runs
+std::string benchmark_id(const BenchmarkResult& result) {
+  auto id = result.name;
+  for (const auto& [key, value] : result.parameters) id += "/" + key + "=" + value;
+  return id;
+}
+
+struct DurationStatistics {
+  double min_ns;
+  double median_ns;
+  double mean_ns;
+};
+
+DurationStatistics duration_statistics(std::vector<std::chrono::nanoseconds> durations) {
+  if (durations.empty()) return {0, 0, 0};
+  std::sort(durations.begin(), durations.end());
+  const auto sum = std::accumulate(durations.begin(), durations.end(), std::chrono::nanoseconds{0});
+  const auto middle = durations.size() / 2;
+  const auto median = durations.size() % 2 == 1 ? static_cast<double>(durations[middle].count())
+                                                 : (durations[middle - 1].count() + durations[middle].count()) / 2.0;
+  return {static_cast<double>(durations.front().count()), median,
+          static_cast<double>(sum.count()) / static_cast<double>(durations.size())};
+}
+
+}  // namespace
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig& config, std::ostream& progress)
+    : _config{config}, _progress{progress} {}
+
+const BenchmarkConfig& BenchmarkRunner::config() const { return _config; }
+
+const std::vector<BenchmarkResult>& BenchmarkRunner::results() const { return _results; }
+
+void BenchmarkRunner::write_json(std::ostream& out) const {
+  const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  auto date = std::ostringstream{};
+  date << std::put_time(std::gmtime(&now), "%Y-%m-%dT%H:%M:%SZ");
+
+  out << "{\n  \"context\": {\n";
+  out << "    \"date\": \"" << date.str() << "\",\n";
+  out << "    \"build_type\": \"" << (IS_DEBUG ? "Debug" : "Release") << "\",\n";
+  out << "    \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n";
+  out << "    \"row_count\": " << _config.row_count << ",\n";
+  out << "    \"chunk_size\": " << _config.chunk_size << ",\n";
+  out << "    \"repetitions\": " << _config.repetitions << "\n";
+  out << "  },\n  \"benchmarks\": [";
+
+  auto stream = std::ostringstream{};
+  stream << std::fixed << std::setprecision(1);
+  for (size_t index = 0; index < _results.size(); ++index) {
+    const auto& result = _results[index];
+    const auto statistics = duration_statistics(result.durations);
+    stream << (index == 0 ? "\n" : ",\n") << "    {\n";
+    stream << "      \"id\": \"" << escape_json(benchmark_id(result)) << "\",\n";
+    stream << "      \"name\": \"" << escape_json(result.name) << "\",\n";
+    stream << "      \"parameters\": {";
+    for (size_t parameter = 0; parameter < result.parameters.size(); ++parameter) {
+      stream << (parameter == 0 ? "" : ", ") << "\"" << escape_json(result.parameters[parameter].first) << "\": \""
+             << escape_json(result.parameters[parameter].second) << "\"";
+    }
+    stream << "},\n";
+    stream << "      \"items\": " << result.item_count << ",\n";
+    for (const auto& [counter, value] : result.counters) {
+      stream << "      \"" << escape_json(counter) << "\": " << value << ",\n";
+    }
+    stream << "      \"min_ns\": " << statistics.min_ns << ",\n";
+    stream << "      \"median_ns\": " << statistics.median_ns << ",\n";
+    stream << "      \"mean_ns\": " << statistics.mean_ns << ",\n";
+    stream << "      \"items_per_second\": "
+           << (statistics.median_ns > 0 ? static_cast<double>(result.item_count) * 1e9 / statistics.median_ns : 0.0)
+           << "\n    }";
+  }
+  out << stream.str() << "\n  ]\n}\n";
+}
+
+void BenchmarkRunner::_report_progress(const BenchmarkResult& result) {
+  const auto statistics = duration_statistics(result.durations);
+  auto line = std::ostringstream{};
+  line << std::left << std::setw(80) << benchmark_id(result) << " " << std::right << std::fixed
+       << std::setprecision(3) << std::setw(12) << statistics.median_ns / 1e6 << " ms\n";
+  _progress << line.str() << std::flush;
+}
+
+}  // namespace opossum
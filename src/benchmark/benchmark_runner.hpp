@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace opossum {
+
+// Scale and repetitions of all benchmarks, set from the command line
+struct BenchmarkConfig {
+  // the number of rows of the generated tables
+  size_t row_count{size_t{1} << 22};
+  size_t chunk_size{size_t{1} << 16};
+  // Each benchmark is run this many times after one warm-up run. The results include the minimum, median and mean.
+  size_t repetitions{5};
+};
+
+// The parameters that identify a benchmark of a group, e.g., {{"encoding", "Dictionary"}, {"scan_type", "<"}}
+using BenchmarkParameters = std::vector<std::pair<std::string, std::string>>;
+
+struct BenchmarkResult {
+  std::string name;
+  BenchmarkParameters parameters;
+  // the number of items, e.g., rows, processed by one run, which is used to compute the throughput
+  uint64_t item_count;
+  // additional numbers describing a run, e.g., the number of rows a scan produced
+  std::vector<std::pair<std::string, double>> counters;
+  std::vector<std::chrono::nanoseconds> durations;
+};
+
+// Runs benchmarks and collects their results, which are written as JSON, so that the results of different builds can
+// be diffed. Groups of benchmarks are functions that set up their data and call run() for each combination of
+// parameters, see benchmarks.hpp.
+class BenchmarkRunner {
+ public:
+  explicit BenchmarkRunner(const BenchmarkConfig& config, std::ostream& progress = std::cerr);
+
+  const BenchmarkConfig& config() const;
+
+  // Calls function once as a warm-up and then config().repetitions times while measuring each call. If function
+  // returns a value, e.g., the output of an operator, it is destroyed after the measurement. Returns the result, to
+  // which the caller may add counters.
+  template <typename Function>
+  BenchmarkResult& run(const std::string& name, const BenchmarkParameters& parameters, const uint64_t item_count,
+                       const Function& function) {
+    auto& result = _results.emplace_back(BenchmarkResult{name, parameters, item_count, {}, {}});
+    function();
+    for (size_t repetition = 0; repetition < _config.repetitions; ++repetition) {
+      const auto begin = std::chrono::steady_clock::now();
+      if constexpr (std::is_void_v<decltype(function())>) {
+        function();
+        result.durations.emplace_back(std::chrono::steady_clock::now() - begin);
+      } else {
+        const auto value = function();
+        result.durations.emplace_back(std::chrono::steady_clock::now() - begin);
+      }
+    }
+    _report_progress(result);
+    return result;
+  }
+
+  const std::vector<BenchmarkResult>& results() const;
+
+  // writes the configuration and all results as a JSON object
+  void write_json(std::ostream& out) const;
+
+ protected:
+  void _report_progress(const BenchmarkResult& result);
+
+  const BenchmarkConfig _config;
+  std::ostream& _progress;
+  std::vector<BenchmarkResult> _results;
+};
+
+}  // namespace opossum
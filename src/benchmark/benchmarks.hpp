@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "benchmark_runner.hpp"
+
+namespace opossum {
+
+class Table;
+
+// Each group of benchmarks generates its data and runs its benchmarks for all combinations of its parameters
+
+// TableScan on each segment type, for code widths of 8 (fitted), 12 (bit-packed) and 16 (fitted) bits, several
+// selectivities and all scan types
+void run_table_scan_benchmarks(BenchmarkRunner& runner);
+
+// The scalar, SSE4.2 and AVX2 kernels that scan attribute vectors of 8, 16 and 32 bit codes, for several
+// selectivities. Only the kernels supported by the executing CPU are run.
+void run_scan_kernels_benchmarks(BenchmarkRunner& runner);
+
+// Encoding a ValueSegment into a DictionarySegment, for int and string values with few and many distinct values
+void run_dictionary_segment_benchmarks(BenchmarkRunner& runner);
+
+// load_table of a generated .tbl file, single-threaded and parallel, with and without encoding the chunks
+void run_load_table_benchmarks(BenchmarkRunner& runner);
+
+// Reading the values referenced by the output of a TableScan using the segment iterables and using operator[]
+void run_reference_segment_benchmarks(BenchmarkRunner& runner);
+
+// Returns a table with a single int column "a" whose values are uniformly distributed in [0, distinct_value_count).
+// It is generated in parallel by generate_table, always with the same seed.
+std::shared_ptr<Table> make_uniform_int_table(const BenchmarkConfig& config, size_t distinct_value_count);
+
+}  // namespace opossum
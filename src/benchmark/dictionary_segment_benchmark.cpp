@@ -0,0 +1,46 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmarks.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+void run_dictionary_segment_benchmarks(BenchmarkRunner& runner) {
+  const auto segment_size = runner.config().chunk_size;
+
+  for (const auto distinct_value_count : {size_t{16}, size_t{4096}, size_t{65536}}) {
+    auto generator = std::mt19937{42};
+    auto distribution = std::uniform_int_distribution<int32_t>{0, static_cast<int32_t>(distinct_value_count - 1)};
+
+    auto int_values = ValueVector<int32_t>{};
+    auto string_values = ValueVector<std::string>{};
+    for (size_t row = 0; row < segment_size; ++row) {
+      const auto value = distribution(generator);
+      int_values.emplace_back(value);
+      // Strings with a common prefix, like customer names in TPC-H
+      string_values.emplace_back("Customer#" + std::to_string(1'000'000'000 + value));
+    }
+    const auto int_segment = std::make_shared<ValueSegment<int32_t>>(std::move(int_values));
+    const auto string_segment = std::make_shared<ValueSegment<std::string>>(std::move(string_values));
+
+    runner.run("DictionarySegment",
+               {{"data_type", "int"}, {"format", "Plain"}, {"distinct", std::to_string(distinct_value_count)}},
+               segment_size, [&] { return std::make_shared<DictionarySegment<int32_t>>(int_segment); });
+
+    for (const auto& [format_name, format] :
+         {std::pair{"Plain", DictionaryFormat::Plain}, std::pair{"FrontCoded", DictionaryFormat::FrontCoded}}) {
+      runner.run("DictionarySegment",
+                 {{"data_type", "string"}, {"format", format_name}, {"distinct", std::to_string(distinct_value_count)}},
+                 segment_size, [&, format = format] {
+                   return std::make_shared<DictionarySegment<std::string>>(string_segment, format);
+                 });
+    }
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,50 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmarks.hpp"
+#include "storage/table.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+void run_load_table_benchmarks(BenchmarkRunner& runner) {
+  const auto& config = runner.config();
+
+  // A table with an int, a string and a double column, similar to TPC-H lineitem's key, flag and price
+  const auto file_name = (std::filesystem::temp_directory_path() / "opossum_load_table_benchmark.tbl").string();
+  {
+    auto generator = std::mt19937{42};
+    auto file = std::ofstream{file_name};
+    file << "key|flag|price\nint|string|double\n";
+    for (size_t row = 0; row < config.row_count; ++row) {
+      file << row << '|' << "AFNOR"[generator() % 5] << '|' << (generator() % 10'000'000) / 100.0 << '\n';
+    }
+  }
+  const auto file_size = std::filesystem::file_size(file_name);
+
+  auto thread_counts = std::vector<size_t>{1};
+  if (std::thread::hardware_concurrency() > 1) thread_counts.emplace_back(std::thread::hardware_concurrency());
+  for (const auto thread_count : thread_counts) {
+    for (const auto& encoding_type : {std::optional<EncodingType>{}, std::optional{EncodingType::Dictionary}}) {
+      auto options = LoadTableOptions{};
+      options.thread_count = thread_count;
+      options.encoding_type = encoding_type;
+      const auto parameters = BenchmarkParameters{{"threads", std::to_string(thread_count)},
+                                                  {"encoding", encoding_type ? "Dictionary" : "Unencoded"}};
+      auto& result = runner.run("LoadTable", parameters, config.row_count, [&] {
+        return load_table(file_name, static_cast<uint32_t>(config.chunk_size), options);
+      });
+      result.counters.emplace_back("bytes", static_cast<double>(file_size));
+    }
+  }
+
+  std::filesystem::remove(file_name);
+}
+
+}  // namespace opossum
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmarks.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterables.hpp"
+#include "storage/table.hpp"
+#include "type_cast.hpp"
+
+namespace opossum {
+
+void run_reference_segment_benchmarks(BenchmarkRunner& runner) {
+  const auto& config = runner.config();
+
+  for (const auto& [encoding_name, encoding_type] :
+       {std::pair<std::string, std::optional<EncodingType>>{"Unencoded", std::nullopt},
+        std::pair<std::string, std::optional<EncodingType>>{"Dictionary", EncodingType::Dictionary}}) {
+    const auto table = make_uniform_int_table(config, 1000);
+    if (encoding_type) table->compress(ChunkEncodingSpec{*encoding_type});
+    auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+
+    for (const auto selectivity : {10, 500}) {
+      // The output of a TableScan references one chunk per output chunk, in the order of the rows
+      auto table_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, selectivity);
+      table_scan->execute();
+      auto scan_segments = std::vector<std::shared_ptr<const BaseSegment>>{};
+      auto all_row_ids = std::make_shared<PosList>();
+      const auto output = table_scan->get_output();
+      for (ChunkID chunk_id{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+        const auto segment = output->get_chunk(chunk_id).get_segment(ColumnID{0});
+        scan_segments.emplace_back(segment);
+        std::static_pointer_cast<const ReferenceSegment>(segment)->for_each_row_id(
+            [&](const RowID& row_id) { all_row_ids->emplace_back(row_id); });
+      }
+
+      // The same positions in random order, as produced by a join or a sort
+      std::shuffle(all_row_ids->begin(), all_row_ids->end(), std::mt19937{42});
+      using Segments = std::vector<std::shared_ptr<const BaseSegment>>;
+      const auto shuffled_segments = Segments{std::make_shared<ReferenceSegment>(table, ColumnID{0}, all_row_ids)};
+
+      using Order = std::pair<std::string, const Segments*>;
+      for (const auto& [order_name, segments] : {Order{"chunk_aligned", &scan_segments},
+                                                 Order{"shuffled", &shuffled_segments}}) {
+        const auto parameters_with_access = [&, encoding_name = encoding_name,
+                                             order_name = order_name](const std::string& access) {
+          return BenchmarkParameters{{"encoding", encoding_name},
+                                     {"selectivity", selectivity == 10 ? "0.01" : "0.50"},
+                                     {"order", order_name},
+                                     {"access", access}};
+        };
+
+        runner.run("ReferenceSegment", parameters_with_access("iterable"), all_row_ids->size(),
+                   [&, segments = segments] {
+                     auto sum = int64_t{0};
+                     for (const auto& segment : *segments) {
+                       segment_for_each<int32_t>(*segment,
+                                                 [&](const int32_t value, const ChunkOffset) { sum += value; });
+                     }
+                     return sum;
+                   });
+
+        runner.run("ReferenceSegment", parameters_with_access("operator[]"), all_row_ids->size(),
+                   [&, segments = segments] {
+                     auto sum = int64_t{0};
+                     for (const auto& segment : *segments) {
+                       for (size_t position = 0; position < segment->size(); ++position) {
+                         sum += type_cast<int32_t>((*segment)[position]);
+                       }
+                     }
+                     return sum;
+                   });
+      }
+    }
+  }
+}
+
+}  // namespace opossum
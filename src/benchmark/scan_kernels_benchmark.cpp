@@ -0,0 +1,66 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmarks.hpp"
+#include "operators/scan_kernels.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+namespace {
+
+std::string kernel_set_name(const ScanKernelSet kernel_set) {
+  switch (kernel_set) {
+    case ScanKernelSet::Scalar:
+      return "Scalar";
+    case ScanKernelSet::SSE42:
+      return "SSE4.2";
+    case ScanKernelSet::AVX2:
+      return "AVX2";
+  }
+  return "unknown";
+}
+
+template <typename T>
+void run_scan_kernel_benchmarks(BenchmarkRunner& runner) {
+  const auto code_count = runner.config().row_count;
+
+  // Codes are uniformly distributed in [0, 100), so a search for code x with OpLessThan selects x percent of the rows
+  auto generator = std::mt19937{42};
+  auto distribution = std::uniform_int_distribution<uint32_t>{0, 99};
+  auto codes = std::vector<T>(code_count);
+  for (auto& code : codes) code = static_cast<T>(distribution(generator));
+
+  // The positions are written to memory that has been touched before, like with a PosList reused by the scan
+  auto pos_list = PosList{};
+  pos_list.reserve(code_count);
+
+  for (const auto selectivity : {T{1}, T{10}, T{50}, T{90}}) {
+    for (const auto kernel_set : {ScanKernelSet::Scalar, ScanKernelSet::SSE42, ScanKernelSet::AVX2}) {
+      if (!scan_kernel_set_supported(kernel_set)) continue;
+
+      const auto parameters =
+          BenchmarkParameters{{"code_width", std::to_string(sizeof(T) * 8)},
+                              {"kernel_set", kernel_set_name(kernel_set)},
+                              {"selectivity", std::to_string(static_cast<uint32_t>(selectivity)) + "%"}};
+      auto& result = runner.run("ScanKernels", parameters, code_count, [&] {
+        pos_list.clear();
+        scan_codes(codes.data(), codes.size(), ScanType::OpLessThan, selectivity, ChunkID{0}, 0, pos_list,
+                   kernel_set);
+      });
+      result.counters.emplace_back("output_rows", static_cast<double>(pos_list.size()));
+    }
+  }
+}
+
+}  // namespace
+
+void run_scan_kernels_benchmarks(BenchmarkRunner& runner) {
+  run_scan_kernel_benchmarks<uint8_t>(runner);
+  run_scan_kernel_benchmarks<uint16_t>(runner);
+  run_scan_kernel_benchmarks<uint32_t>(runner);
+}
+
+}  // namespace opossum
@@ -0,0 +1,102 @@
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmarks.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/encoding_type.hpp"
+#include "storage/table.hpp"
+#include "utils/table_generator.hpp"
+
+namespace opossum {
+
+namespace {
+
+std::string scan_type_name(const ScanType scan_type) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return "=";
+    case ScanType::OpNotEquals:
+      return "!=";
+    case ScanType::OpLessThan:
+      return "<";
+    case ScanType::OpLessThanEquals:
+      return "<=";
+    case ScanType::OpGreaterThan:
+      return ">";
+    case ScanType::OpGreaterThanEquals:
+      return ">=";
+  }
+  return "unknown";
+}
+
+}  // namespace
+
+std::shared_ptr<Table> make_uniform_int_table(const BenchmarkConfig& config, const size_t distinct_value_count) {
+  auto column = ColumnSpecification{};
+  column.name = "a";
+  column.type = "int";
+  column.distinct_value_count = distinct_value_count;
+  auto options = TableGeneratorOptions{};
+  options.chunk_size = static_cast<uint32_t>(config.chunk_size);
+  return generate_table({column}, config.row_count, options);
+}
+
+void run_table_scan_benchmarks(BenchmarkRunner& runner) {
+  const auto& config = runner.config();
+  const auto encodings = std::vector<std::pair<std::string, std::optional<EncodingType>>>{
+      {"Unencoded", std::nullopt},
+      {"Dictionary", EncodingType::Dictionary},
+      {"RunLength", EncodingType::RunLength},
+      {"FrameOfReference", EncodingType::FrameOfReference}};
+
+  for (const auto code_width : {8, 12, 16}) {
+    // Dictionaries and frames of reference of a domain of 2^code_width values need codes of code_width bits
+    const auto distinct_value_count = size_t{1} << code_width;
+    for (const auto& [encoding_name, encoding_type] : encodings) {
+      const auto table = make_uniform_int_table(config, distinct_value_count);
+      if (encoding_type) table->compress(ChunkEncodingSpec{*encoding_type});
+      auto table_wrapper = std::make_shared<TableWrapper>(table);
+      table_wrapper->execute();
+
+      for (const auto scan_type : {ScanType::OpEquals, ScanType::OpNotEquals, ScanType::OpLessThan,
+                                   ScanType::OpLessThanEquals, ScanType::OpGreaterThan,
+                                   ScanType::OpGreaterThanEquals}) {
+        // The selectivity of = and != is given by the number of distinct values
+        const auto selectivities = scan_type == ScanType::OpEquals || scan_type == ScanType::OpNotEquals
+                                       ? std::vector<double>{-1.0}
+                                       : std::vector<double>{0.01, 0.5, 0.99};
+        for (const auto selectivity : selectivities) {
+          // Values less than the search value make up the share selectivity of all values
+          auto search_value = static_cast<int32_t>(distinct_value_count / 2);
+          if (selectivity >= 0) {
+            const auto share = scan_type == ScanType::OpLessThan || scan_type == ScanType::OpLessThanEquals
+                                   ? selectivity
+                                   : 1.0 - selectivity;
+            search_value = static_cast<int32_t>(share * static_cast<double>(distinct_value_count));
+          }
+
+          const auto parameters = BenchmarkParameters{
+              {"encoding", encoding_name},
+              {"code_width", std::to_string(code_width)},
+              {"scan_type", scan_type_name(scan_type)},
+              {"selectivity", selectivity >= 0 ? std::to_string(selectivity).substr(0, 4)
+                                               : scan_type == ScanType::OpEquals ? "1/distinct" : "1-1/distinct"}};
+          auto output_row_count = size_t{0};
+          auto& result = runner.run("TableScan", parameters, table->row_count(), [&] {
+            auto table_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan_type, search_value);
+            table_scan->execute();
+            output_row_count = table_scan->get_output()->row_count();
+            return table_scan;
+          });
+          result.counters.emplace_back("output_rows", static_cast<double>(output_row_count));
+        }
+      }
+    }
+  }
+}
+
+}  // namespace opossum
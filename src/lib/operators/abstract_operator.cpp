@@ -1,12 +1,17 @@
 #include "abstract_operator.hpp"
 
 #include <chrono>
+#include <iomanip>
 #include <memory>
+#include <ostream>
+#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
+#include "utils/query_arena.hpp"
 
 namespace opossum {
 
@@ -14,7 +19,27 @@ AbstractOperator::AbstractOperator(const std::shared_ptr<const AbstractOperator>
                                    const std::shared_ptr<const AbstractOperator> right)
     : _input_left(left), _input_right(right) {}
 
-void AbstractOperator::execute() { _output = _on_execute(); }
+void AbstractOperator::execute() {
+  const auto arena_bytes_before = _arena ? _arena->allocated_bytes() : size_t{0};
+  const auto begin = std::chrono::steady_clock::now();
+  _output = _on_execute();
+  _performance_data.walltime = std::chrono::steady_clock::now() - begin;
+  _performance_data.arena_allocated_bytes = _arena ? _arena->allocated_bytes() - arena_bytes_before : size_t{0};
+
+  if (_input_left) {
+    _performance_data.left_input_row_count = _input_table_left()->row_count();
+    _performance_data.left_input_chunk_count = _input_table_left()->chunk_count();
+  }
+  if (_input_right) {
+    _performance_data.right_input_row_count = _input_table_right()->row_count();
+    _performance_data.right_input_chunk_count = _input_table_right()->chunk_count();
+  }
+  if (_output) {
+    _performance_data.output_row_count = _output->row_count();
+    _performance_data.output_chunk_count = _output->chunk_count();
+    _performance_data.output_memory_usage = _output->estimate_memory_usage();
+  }
+}
 
 std::shared_ptr<const Table> AbstractOperator::get_output() const {
   // TODO(anyone): You should place some meaningful checks here
@@ -30,4 +55,44 @@ std::shared_ptr<const AbstractOperator> AbstractOperator::input_left() const { r
 
 std::shared_ptr<const AbstractOperator> AbstractOperator::input_right() const { return _input_right; }
 
+const std::string AbstractOperator::description() const { return name(); }
+
+const OperatorPerformanceData& AbstractOperator::performance_data() const {
+  DebugAssert(_output, "Operator was not executed yet");
+  return _performance_data;
+}
+
+void AbstractOperator::print_plan(std::ostream& out) const { _print_plan(out, 0); }
+
+void AbstractOperator::_print_plan(std::ostream& out, const size_t depth) const {
+  // The line is formatted separately, so that the formatting flags of out are left untouched
+  auto line = std::ostringstream{};
+  line << std::string(2 * depth, ' ') << description();
+  if (_output) {
+    const auto& data = _performance_data;
+    line << " | " << std::fixed << std::setprecision(1)
+         << std::chrono::duration<double, std::micro>{data.walltime}.count() << " us | rows: ";
+    if (_input_left) line << data.left_input_row_count;
+    if (_input_right) line << ", " << data.right_input_row_count;
+    if (_input_left) line << " -> ";
+    line << data.output_row_count << " | chunks: ";
+    if (_input_left) line << data.left_input_chunk_count;
+    if (_input_right) line << ", " << data.right_input_chunk_count;
+    if (_input_left) line << " -> ";
+    line << data.output_chunk_count << " | output: " << data.output_memory_usage << " B";
+    if (_arena) line << " | arena: " << data.arena_allocated_bytes << " B";
+  } else {
+    line << " | not executed";
+  }
+  out << line.str() << "\n";
+
+  if (_input_left) _input_left->_print_plan(out, depth + 1);
+  if (_input_right) _input_right->_print_plan(out, depth + 1);
+}
+
+void AbstractOperator::set_arena(std::shared_ptr<QueryArena> arena) {
+  DebugAssert(!_output, "Operator was executed already");
+  _arena = std::move(arena);
+}
+
 }  // namespace opossum
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -8,14 +10,42 @@
 
 namespace opossum {
 
+class QueryArena;
 class Table;
 
+// Measured by AbstractOperator::execute, so that slow operators of a plan can be found without a profiler
+struct OperatorPerformanceData {
+  // the time spent executing the operator itself, i.e., without its inputs
+  std::chrono::nanoseconds walltime{0};
+
+  // the sizes of the input tables, which are zero if the operator has no such input
+  uint64_t left_input_row_count{0};
+  uint64_t left_input_chunk_count{0};
+  uint64_t right_input_row_count{0};
+  uint64_t right_input_chunk_count{0};
+
+  uint64_t output_row_count{0};
+  uint64_t output_chunk_count{0};
+
+  // The memory used by the output table, see Table::estimate_memory_usage. For operators producing ReferenceSegments,
+  // this is mostly the memory of the positions. Operators forwarding a stored table, such as GetTable, report the
+  // size of that table.
+  size_t output_memory_usage{0};
+
+  // The number of bytes allocated from the arena during the execution, see set_arena, or zero if there is no arena.
+  // Since the arena does not reuse memory, this includes temporary allocations and thus is an upper bound of the
+  // operator's peak memory usage for intermediates. If operators sharing the arena are executed concurrently, their
+  // allocations are included as well.
+  size_t arena_allocated_bytes{0};
+};
+
 // AbstractOperator is the abstract super class for all operators.
 // All operators have up to two input tables and one output table.
 // Their lifecycle has three phases:
 // 1. The operator is constructed. Previous operators are not guaranteed to have already executed, so operators must not
 // call get_output in their execute method
-// 2. The execute method is called from the outside (usually by the scheduler). This is where the heavy lifting is done.
+// 2. The execute method is called from the outside (usually by the scheduler, see OperatorTask). This is where the
+// heavy lifting is done.
 // By now, the input operators have already executed.
 // 3. The consumer (usually another operator) calls get_output. This should be very cheap. It is only guaranteed to
 // succeed if execute was called before. Otherwise, a nullptr or an empty table could be returned.
@@ -36,15 +66,34 @@ class AbstractOperator : private Noncopyable {
   AbstractOperator(AbstractOperator&&) = default;
   AbstractOperator& operator=(AbstractOperator&&) = default;
 
+  // executes the operator and measures its performance_data
   void execute();
 
   // returns the result of the operator
   std::shared_ptr<const Table> get_output() const;
 
+  // returns the name of the operator, e.g., "TableScan"
+  virtual const std::string name() const = 0;
+
+  // returns the name and the parameters of the operator, e.g., "TableScan a > 5"
+  virtual const std::string description() const;
+
+  // Is only valid after the operator was executed
+  const OperatorPerformanceData& performance_data() const;
+
+  // Prints the operator and its inputs as a tree with one line per operator, showing its description and performance
+  // data. Inputs are indented below the operators consuming them.
+  void print_plan(std::ostream& out = std::cout) const;
+
   // Get the input operators.
   std::shared_ptr<const AbstractOperator> input_left() const;
   std::shared_ptr<const AbstractOperator> input_right() const;
 
+  // Makes the operator allocate its intermediate results, such as the positions found by a TableScan, from the given
+  // arena instead of the global allocator. All operators of a query should share one arena. Must be called before
+  // execute().
+  void set_arena(std::shared_ptr<QueryArena> arena);
+
  protected:
   // abstract method to actually execute the operator
   // execute and get_output are split into two methods to allow for easier
@@ -54,12 +103,19 @@ class AbstractOperator : private Noncopyable {
   std::shared_ptr<const Table> _input_table_left() const;
   std::shared_ptr<const Table> _input_table_right() const;
 
+  void _print_plan(std::ostream& out, size_t depth) const;
+
   // Shared pointers to input operators, can be nullptr.
   std::shared_ptr<const AbstractOperator> _input_left;
   std::shared_ptr<const AbstractOperator> _input_right;
 
   // Is nullptr until the operator is executed
   std::shared_ptr<const Table> _output;
+
+  // Is nullptr unless set_arena was called
+  std::shared_ptr<QueryArena> _arena;
+
+  OperatorPerformanceData _performance_data;
 };
 
 }  // namespace opossum
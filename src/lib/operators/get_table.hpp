@@ -15,6 +15,9 @@ class GetTable : public AbstractOperator {
 
   const std::string& table_name() const;
 
+  const std::string name() const override;
+  const std::string description() const override;
+
  protected:
   std::shared_ptr<const Table> _on_execute() override;
 
@@ -4,17 +4,34 @@
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "operators/table_wrapper.hpp"
 #include "storage/base_segment.hpp"
+#include "storage/segment_iterables.hpp"
 #include "storage/table.hpp"
-#include "type_cast.hpp"
-#include "utils/performance_warning.hpp"
 
 namespace opossum {
 
+namespace {
+
+// Formats the values of a segment like operator<< formats AllTypeVariants, without a virtual call per value
+std::vector<std::string> format_segment(const std::string& data_type, const BaseSegment& segment) {
+  std::vector<std::string> cells;
+  cells.reserve(segment.size());
+  auto stream = std::ostringstream{};
+  segment_for_each(data_type, segment, [&](const auto& value, const auto) {
+    stream.str("");
+    stream << value;
+    cells.emplace_back(stream.str());
+  });
+  return cells;
+}
+
+}  // namespace
+
 Print::Print(const std::shared_ptr<const AbstractOperator> in, std::ostream& out) : AbstractOperator(in), _out(out) {}
 
 void Print::print(std::shared_ptr<const Table> table, std::ostream& out) {
@@ -23,9 +40,9 @@ void Print::print(std::shared_ptr<const Table> table, std::ostream& out) {
   Print(table_wrapper, out).execute();
 }
 
-std::shared_ptr<const Table> Print::_on_execute() {
-  PerformanceWarningDisabler pwd;
+const std::string Print::name() const { return "Print"; }
 
+std::shared_ptr<const Table> Print::_on_execute() {
   auto widths = column_string_widths(8, 20, _input_table_left());
 
   // print column headers
@@ -50,13 +67,16 @@ std::shared_ptr<const Table> Print::_on_execute() {
       continue;
     }
 
-    // print the rows in the chunk
+    // print the rows in the chunk, after formatting its values column by column
+    std::vector<std::vector<std::string>> columns;
+    for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
+      columns.emplace_back(
+          format_segment(_input_table_left()->column_type(column_id), *chunk.get_segment(column_id)));
+    }
     for (size_t row = 0; row < chunk.size(); ++row) {
       _out << "|";
       for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
-        // well yes, we use BaseSegment::operator[] here, but since Print is not an operation that should
-        // be part of a regular query plan, let's keep things simple here
-        _out << std::setw(widths[column_id]) << (*chunk.get_segment(column_id))[row] << "|" << std::setw(0);
+        _out << std::setw(widths[column_id]) << columns[column_id][row] << "|" << std::setw(0);
       }
 
       _out << std::endl;
@@ -77,13 +97,12 @@ std::vector<uint16_t> Print::column_string_widths(uint16_t min, uint16_t max, st
   }
 
   // go over all rows and find the maximum length of the printed representation of a value, up to max
-  for (ChunkID chunk_id{0}; chunk_id < _input_table_left()->chunk_count(); ++chunk_id) {
-    auto& chunk = _input_table_left()->get_chunk(chunk_id);
+  for (ChunkID chunk_id{0}; chunk_id < t->chunk_count(); ++chunk_id) {
+    auto& chunk = t->get_chunk(chunk_id);
 
     for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
-      for (size_t row = 0; row < chunk.size(); ++row) {
-        auto cell_length =
-            static_cast<uint16_t>(boost::lexical_cast<std::string>((*chunk.get_segment(column_id))[row]).size());
+      for (const auto& cell : format_segment(t->column_type(column_id), *chunk.get_segment(column_id))) {
+        auto cell_length = static_cast<uint16_t>(cell.size());
         widths[column_id] = std::max({min, widths[column_id], std::min(max, cell_length)});
       }
     }
@@ -0,0 +1,289 @@
+#include "scan_kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define OPOSSUM_SCAN_KERNELS_X86 1
+#else
+#define OPOSSUM_SCAN_KERNELS_X86 0
+#endif
+
+#include <cstdint>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The SIMD kernels only compute ==, >= and <=. The remaining scan types are the complement of one of them:
+// != is the complement of ==, < of >=, and > of <=.
+template <ScanType scan_type>
+constexpr bool is_inverted() {
+  return scan_type == ScanType::OpNotEquals || scan_type == ScanType::OpLessThan ||
+         scan_type == ScanType::OpGreaterThan;
+}
+
+template <ScanType scan_type, typename T>
+bool compare(const T lhs, const T rhs) {
+  if constexpr (scan_type == ScanType::OpEquals) {
+    return lhs == rhs;
+  } else if constexpr (scan_type == ScanType::OpNotEquals) {
+    return lhs != rhs;
+  } else if constexpr (scan_type == ScanType::OpLessThan) {
+    return lhs < rhs;
+  } else if constexpr (scan_type == ScanType::OpLessThanEquals) {
+    return lhs <= rhs;
+  } else if constexpr (scan_type == ScanType::OpGreaterThan) {
+    return lhs > rhs;
+  } else {
+    static_assert(scan_type == ScanType::OpGreaterThanEquals, "Unknown scan type");
+    return lhs >= rhs;
+  }
+}
+
+template <ScanType scan_type, typename T>
+void scan_codes_scalar(const T* codes, size_t count, T search_code, ChunkID chunk_id, ChunkOffset first_offset,
+                       PosList& pos_list) {
+  for (size_t index = 0; index < count; ++index) {
+    if (compare<scan_type>(codes[index], search_code)) {
+      pos_list.emplace_back(RowID{chunk_id, static_cast<ChunkOffset>(first_offset + index)});
+    }
+  }
+}
+
+// Appends one RowID per set bit of mask, where bit i represents the code at block_offset + i
+inline void append_matches(uint32_t mask, ChunkID chunk_id, ChunkOffset block_offset, PosList& pos_list) {
+  while (mask != 0) {
+    pos_list.emplace_back(RowID{chunk_id, block_offset + static_cast<ChunkOffset>(__builtin_ctz(mask))});
+    mask &= mask - 1;
+  }
+}
+
+#if OPOSSUM_SCAN_KERNELS_X86
+
+#define OPOSSUM_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define OPOSSUM_TARGET_AVX2 __attribute__((target("avx2")))
+
+// SSE4.2 kernels: 16 codes per block
+
+template <typename T>
+OPOSSUM_TARGET_SSE42 __m128i sse42_broadcast(const T code) {
+  if constexpr (sizeof(T) == 1) {
+    return _mm_set1_epi8(static_cast<char>(code));
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm_set1_epi16(static_cast<int16_t>(code));
+  } else {
+    return _mm_set1_epi32(static_cast<int32_t>(code));
+  }
+}
+
+// Returns a vector with all bits of an element set if the element matches the non-inverted scan type.
+// Codes are unsigned, so >= and <= are expressed via unsigned max/min followed by a comparison for equality.
+template <ScanType scan_type, typename T>
+OPOSSUM_TARGET_SSE42 __m128i sse42_compare(const __m128i values, const __m128i search) {
+  constexpr auto equals = scan_type == ScanType::OpEquals || scan_type == ScanType::OpNotEquals;
+  constexpr auto greater_equals = scan_type == ScanType::OpGreaterThanEquals || scan_type == ScanType::OpLessThan;
+  if constexpr (sizeof(T) == 1) {
+    if constexpr (equals) return _mm_cmpeq_epi8(values, search);
+    if constexpr (greater_equals) return _mm_cmpeq_epi8(_mm_max_epu8(values, search), values);
+    return _mm_cmpeq_epi8(_mm_min_epu8(values, search), values);
+  } else if constexpr (sizeof(T) == 2) {  // NOLINT(readability/braces)
+    if constexpr (equals) return _mm_cmpeq_epi16(values, search);
+    if constexpr (greater_equals) return _mm_cmpeq_epi16(_mm_max_epu16(values, search), values);
+    return _mm_cmpeq_epi16(_mm_min_epu16(values, search), values);
+  } else {
+    if constexpr (equals) return _mm_cmpeq_epi32(values, search);
+    if constexpr (greater_equals) return _mm_cmpeq_epi32(_mm_max_epu32(values, search), values);
+    return _mm_cmpeq_epi32(_mm_min_epu32(values, search), values);
+  }
+}
+
+// Compares 16 codes and returns a bit mask with one bit per code. Wider codes are compared in multiple vectors whose
+// results are narrowed to one byte per code with saturating packs (the comparison results are either 0 or -1).
+template <ScanType scan_type, typename T>
+OPOSSUM_TARGET_SSE42 uint32_t sse42_block_mask(const T* codes, const __m128i search) {
+  const auto vectors = reinterpret_cast<const __m128i*>(codes);
+  __m128i matches;
+  if constexpr (sizeof(T) == 1) {
+    matches = sse42_compare<scan_type, T>(_mm_loadu_si128(vectors), search);
+  } else if constexpr (sizeof(T) == 2) {
+    matches = _mm_packs_epi16(sse42_compare<scan_type, T>(_mm_loadu_si128(vectors), search),
+                              sse42_compare<scan_type, T>(_mm_loadu_si128(vectors + 1), search));
+  } else {
+    const auto low = _mm_packs_epi32(sse42_compare<scan_type, T>(_mm_loadu_si128(vectors), search),
+                                     sse42_compare<scan_type, T>(_mm_loadu_si128(vectors + 1), search));
+    const auto high = _mm_packs_epi32(sse42_compare<scan_type, T>(_mm_loadu_si128(vectors + 2), search),
+                                      sse42_compare<scan_type, T>(_mm_loadu_si128(vectors + 3), search));
+    matches = _mm_packs_epi16(low, high);
+  }
+
+  auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+  if constexpr (is_inverted<scan_type>()) mask = ~mask & 0xFFFFu;
+  return mask;
+}
+
+template <ScanType scan_type, typename T>
+OPOSSUM_TARGET_SSE42 void scan_codes_sse42(const T* codes, size_t count, T search_code, ChunkID chunk_id,
+                                           ChunkOffset first_offset, PosList& pos_list) {
+  constexpr size_t block_size = 16;
+  const auto search = sse42_broadcast(search_code);
+
+  size_t index = 0;
+  for (; index + block_size <= count; index += block_size) {
+    const auto mask = sse42_block_mask<scan_type>(codes + index, search);
+    append_matches(mask, chunk_id, static_cast<ChunkOffset>(first_offset + index), pos_list);
+  }
+
+  scan_codes_scalar<scan_type>(codes + index, count - index, search_code, chunk_id,
+                               static_cast<ChunkOffset>(first_offset + index), pos_list);
+}
+
+// AVX2 kernels: 32 codes per block
+
+template <typename T>
+OPOSSUM_TARGET_AVX2 __m256i avx2_broadcast(const T code) {
+  if constexpr (sizeof(T) == 1) {
+    return _mm256_set1_epi8(static_cast<char>(code));
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm256_set1_epi16(static_cast<int16_t>(code));
+  } else {
+    return _mm256_set1_epi32(static_cast<int32_t>(code));
+  }
+}
+
+// See sse42_compare
+template <ScanType scan_type, typename T>
+OPOSSUM_TARGET_AVX2 __m256i avx2_compare(const __m256i values, const __m256i search) {
+  constexpr auto equals = scan_type == ScanType::OpEquals || scan_type == ScanType::OpNotEquals;
+  constexpr auto greater_equals = scan_type == ScanType::OpGreaterThanEquals || scan_type == ScanType::OpLessThan;
+  if constexpr (sizeof(T) == 1) {
+    if constexpr (equals) return _mm256_cmpeq_epi8(values, search);
+    if constexpr (greater_equals) return _mm256_cmpeq_epi8(_mm256_max_epu8(values, search), values);
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(values, search), values);
+  } else if constexpr (sizeof(T) == 2) {  // NOLINT(readability/braces)
+    if constexpr (equals) return _mm256_cmpeq_epi16(values, search);
+    if constexpr (greater_equals) return _mm256_cmpeq_epi16(_mm256_max_epu16(values, search), values);
+    return _mm256_cmpeq_epi16(_mm256_min_epu16(values, search), values);
+  } else {
+    if constexpr (equals) return _mm256_cmpeq_epi32(values, search);
+    if constexpr (greater_equals) return _mm256_cmpeq_epi32(_mm256_max_epu32(values, search), values);
+    return _mm256_cmpeq_epi32(_mm256_min_epu32(values, search), values);
+  }
+}
+
+// Compares 32 codes and returns a bit mask with one bit per code. The AVX2 pack instructions work within 128 bit
+// lanes, so the packed results need to be permuted back into code order before the mask is extracted.
+template <ScanType scan_type, typename T>
+OPOSSUM_TARGET_AVX2 uint32_t avx2_block_mask(const T* codes, const __m256i search) {
+  const auto vectors = reinterpret_cast<const __m256i*>(codes);
+  __m256i matches;
+  if constexpr (sizeof(T) == 1) {
+    matches = avx2_compare<scan_type, T>(_mm256_loadu_si256(vectors), search);
+  } else if constexpr (sizeof(T) == 2) {  // NOLINT(readability/braces)
+    const auto packed = _mm256_packs_epi16(avx2_compare<scan_type, T>(_mm256_loadu_si256(vectors), search),
+                                           avx2_compare<scan_type, T>(_mm256_loadu_si256(vectors + 1), search));
+    matches = _mm256_permute4x64_epi64(packed, 0xD8);
+  } else {
+    const auto low = _mm256_packs_epi32(avx2_compare<scan_type, T>(_mm256_loadu_si256(vectors), search),
+                                        avx2_compare<scan_type, T>(_mm256_loadu_si256(vectors + 1), search));
+    const auto high = _mm256_packs_epi32(avx2_compare<scan_type, T>(_mm256_loadu_si256(vectors + 2), search),
+                                         avx2_compare<scan_type, T>(_mm256_loadu_si256(vectors + 3), search));
+    const auto packed = _mm256_packs_epi16(low, high);
+    matches = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+  }
+
+  auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+  if constexpr (is_inverted<scan_type>()) mask = ~mask;
+  return mask;
+}
+
+template <ScanType scan_type, typename T>
+OPOSSUM_TARGET_AVX2 void scan_codes_avx2(const T* codes, size_t count, T search_code, ChunkID chunk_id,
+                                         ChunkOffset first_offset, PosList& pos_list) {
+  constexpr size_t block_size = 32;
+  const auto search = avx2_broadcast(search_code);
+
+  size_t index = 0;
+  for (; index + block_size <= count; index += block_size) {
+    const auto mask = avx2_block_mask<scan_type>(codes + index, search);
+    append_matches(mask, chunk_id, static_cast<ChunkOffset>(first_offset + index), pos_list);
+  }
+
+  scan_codes_scalar<scan_type>(codes + index, count - index, search_code, chunk_id,
+                               static_cast<ChunkOffset>(first_offset + index), pos_list);
+}
+
+#endif
+
+template <ScanType scan_type, typename T>
+void scan_codes_with_kernel_set(const T* codes, size_t count, T search_code, ChunkID chunk_id,
+                                ChunkOffset first_offset, PosList& pos_list, ScanKernelSet kernel_set) {
+  switch (kernel_set) {
+#if OPOSSUM_SCAN_KERNELS_X86
+    case ScanKernelSet::AVX2:
+      scan_codes_avx2<scan_type>(codes, count, search_code, chunk_id, first_offset, pos_list);
+      return;
+    case ScanKernelSet::SSE42:
+      scan_codes_sse42<scan_type>(codes, count, search_code, chunk_id, first_offset, pos_list);
+      return;
+#endif
+    default:
+      scan_codes_scalar<scan_type>(codes, count, search_code, chunk_id, first_offset, pos_list);
+  }
+}
+
+}  // namespace
+
+ScanKernelSet detect_scan_kernel_set() {
+  static const auto kernel_set = [] {
+#if OPOSSUM_SCAN_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return ScanKernelSet::AVX2;
+    if (__builtin_cpu_supports("sse4.2")) return ScanKernelSet::SSE42;
+#endif
+    return ScanKernelSet::Scalar;
+  }();
+  return kernel_set;
+}
+
+bool scan_kernel_set_supported(ScanKernelSet kernel_set) {
+  return static_cast<int>(kernel_set) <= static_cast<int>(detect_scan_kernel_set());
+}
+
+template <typename T>
+void scan_codes(const T* codes, size_t count, ScanType scan_type, T search_code, ChunkID chunk_id,
+                ChunkOffset first_offset, PosList& pos_list, ScanKernelSet kernel_set) {
+  DebugAssert(scan_kernel_set_supported(kernel_set), "Scan kernels are not supported by this CPU");
+
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return scan_codes_with_kernel_set<ScanType::OpEquals>(codes, count, search_code, chunk_id, first_offset,
+                                                            pos_list, kernel_set);
+    case ScanType::OpNotEquals:
+      return scan_codes_with_kernel_set<ScanType::OpNotEquals>(codes, count, search_code, chunk_id, first_offset,
+                                                               pos_list, kernel_set);
+    case ScanType::OpLessThan:
+      return scan_codes_with_kernel_set<ScanType::OpLessThan>(codes, count, search_code, chunk_id, first_offset,
+                                                              pos_list, kernel_set);
+    case ScanType::OpLessThanEquals:
+      return scan_codes_with_kernel_set<ScanType::OpLessThanEquals>(codes, count, search_code, chunk_id,
+                                                                    first_offset, pos_list, kernel_set);
+    case ScanType::OpGreaterThan:
+      return scan_codes_with_kernel_set<ScanType::OpGreaterThan>(codes, count, search_code, chunk_id, first_offset,
+                                                                 pos_list, kernel_set);
+    case ScanType::OpGreaterThanEquals:
+      return scan_codes_with_kernel_set<ScanType::OpGreaterThanEquals>(codes, count, search_code, chunk_id,
+                                                                       first_offset, pos_list, kernel_set);
+    default:
+      Fail("Invalid scan type");
+  }
+}
+
+template void scan_codes<uint8_t>(const uint8_t*, size_t, ScanType, uint8_t, ChunkID, ChunkOffset, PosList&,
+                                  ScanKernelSet);
+template void scan_codes<uint16_t>(const uint16_t*, size_t, ScanType, uint16_t, ChunkID, ChunkOffset, PosList&,
+                                   ScanKernelSet);
+template void scan_codes<uint32_t>(const uint32_t*, size_t, ScanType, uint32_t, ChunkID, ChunkOffset, PosList&,
+                                   ScanKernelSet);
+
+}  // namespace opossum
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Scan kernels compare a contiguous array of attribute vector codes (i.e., value ids) against a single search code and
+ * append the RowIDs of all matches to a PosList.
+ *
+ * Besides a scalar implementation, there are SSE4.2 and AVX2 implementations that compare 16 (SSE4.2) or 32 (AVX2)
+ * codes per iteration, build a bit mask of the matches and write RowIDs only for the set bits of that mask. The
+ * instruction set is detected at runtime, so the binary does not need to be built with -march=native to profit from
+ * the SIMD kernels.
+ */
+
+// Instruction sets for which scan kernels exist, ordered by vector width
+enum class ScanKernelSet { Scalar, SSE42, AVX2 };
+
+// Returns the widest instruction set supported by the executing CPU. The CPU is only queried on the first call.
+ScanKernelSet detect_scan_kernel_set();
+
+// Returns true if kernels of the given instruction set can be executed on this CPU
+bool scan_kernel_set_supported(ScanKernelSet kernel_set);
+
+// Compares `count` codes starting at `codes` against `search_code` and appends {chunk_id, first_offset + i} for each
+// matching code i to pos_list. The matches are appended in ascending order of their offsets.
+// Implemented for uint8_t, uint16_t and uint32_t codes.
+template <typename T>
+void scan_codes(const T* codes, size_t count, ScanType scan_type, T search_code, ChunkID chunk_id,
+                ChunkOffset first_offset, PosList& pos_list, ScanKernelSet kernel_set = detect_scan_kernel_set());
+
+}  // namespace opossum
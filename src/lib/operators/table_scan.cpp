@@ -1,65 +1,103 @@
 #include "table_scan.hpp"
 
+#include <algorithm>
+#include <array>
 #include <functional>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "all_type_variant.hpp"
+#include "operators/scan_kernels.hpp"
 #include "resolve_type.hpp"
 #include "storage/base_attribute_vector.hpp"
-#include "storage/fitted_attribute_vector.hpp"
+#include "storage/bit_packed_attribute_vector.hpp"
+#include "storage/row_id_bitmap.hpp"
+#include "storage/segment_iterables.hpp"
+#include "storage/zone_map.hpp"
+#include "utils/parallel.hpp"
+#include "utils/query_arena.hpp"
 
 namespace opossum {
 
-template <class T, ScanType scan_op>
+// The comparators are transparent, so that values stored as std::string_view (see StringHeap) can be compared with a
+// std::string search value without constructing a std::string for each of them
+template <ScanType scan_op>
 auto comparator() {
   if constexpr (scan_op == ScanType::OpEquals) {
-    return std::equal_to<T>{};
+    return std::equal_to<>{};
   } else if constexpr (scan_op == ScanType::OpNotEquals) {
-    return std::not_equal_to<T>{};
+    return std::not_equal_to<>{};
   } else if constexpr (scan_op == ScanType::OpGreaterThan) {
-    return std::greater<T>{};
+    return std::greater<>{};
   } else if constexpr (scan_op == ScanType::OpGreaterThanEquals) {
-    return std::greater_equal<T>{};
+    return std::greater_equal<>{};
   } else if constexpr (scan_op == ScanType::OpLessThan) {
-    return std::less<T>{};
+    return std::less<>{};
   } else {
     static_assert(scan_op == ScanType::OpLessThanEquals, "Unknown scan type");
-    return std::less_equal<T>{};
+    return std::less_equal<>{};
   }
 }
 
-template <ScanType scan_op, class T>
-void scan_vector(const std::vector<T>& data, PosList& pos_list, T search_value, ChunkID chunk_id) {
-  auto compare = comparator<T, scan_op>();
-  for (ChunkOffset offset{0}; offset < data.size(); ++offset) {
+// Converts the search value into the type the values of a ValueVector<T> are accessed as. For strings, this is a
+// std::string_view, so that both sides of a comparison are views.
+template <class T>
+typename ValueVector<T>::const_reference search_value_view(const T& search_value) {
+  return search_value;
+}
+
+template <ScanType scan_op, class Values, class SearchValue>
+void scan_vector(const Values& data, PosList& pos_list, const SearchValue& search_value, ChunkID chunk_id,
+                 ChunkOffset begin, ChunkOffset end) {
+  auto compare = comparator<scan_op>();
+  for (auto offset = begin; offset < end; ++offset) {
     if (compare(data[offset], search_value)) {
       pos_list.emplace_back(RowID{chunk_id, offset});
     }
   }
 }
 
+// Large chunks are split into morsels of this many rows, which are scanned independently, so that a parallel scan of a
+// single chunk can use all threads. It is a multiple of the block size used by scan_attribute_vector.
+constexpr size_t MORSEL_SIZE = 16 * 1024;
+
 template <ScanType scan_op>
 void scan_attribute_vector(std::shared_ptr<const BaseAttributeVector> attribute_vector, PosList& pos_list,
-                           ValueID search_value, ChunkID chunk_id) {
-  if (const auto uint8_vec = std::dynamic_pointer_cast<const FittedAttributeVector<uint8_t>>(attribute_vector);
-      uint8_vec != nullptr) {
-    scan_vector<scan_op>(uint8_vec->indices(), pos_list, static_cast<uint8_t>(search_value), chunk_id);
-  } else if (const auto uint16_vec = std::dynamic_pointer_cast<const FittedAttributeVector<uint16_t>>(attribute_vector);
-             uint16_vec != nullptr) {
-    scan_vector<scan_op>(uint16_vec->indices(), pos_list, static_cast<uint16_t>(search_value), chunk_id);
-  } else if (const auto uint32_vec = std::dynamic_pointer_cast<const FittedAttributeVector<uint32_t>>(attribute_vector);
-             uint32_vec != nullptr) {
-    scan_vector<scan_op>(uint32_vec->indices(), pos_list, static_cast<uint32_t>(search_value), chunk_id);
-  } else {
-    Fail("TableScan not implemented for this type of attribute vector");
-  }
+                           ValueID search_value, ChunkID chunk_id, ChunkOffset begin, ChunkOffset end) {
+  resolve_attribute_vector_type(*attribute_vector, [&](const auto& typed_attribute_vector) {
+    using AttributeVectorType = std::decay_t<decltype(typed_attribute_vector)>;
+    if constexpr (std::is_same_v<AttributeVectorType, BitPackedAttributeVector>) {
+      // Unpack blocks of codes into a buffer small enough to stay in the L1 cache and scan the buffer instead
+      constexpr size_t block_size = 1024;
+      std::array<uint32_t, block_size> codes;
+      for (size_t block_begin = begin; block_begin < end; block_begin += block_size) {
+        const auto count = std::min(block_size, end - block_begin);
+        typed_attribute_vector.decode(block_begin, count, codes.data());
+        scan_codes(codes.data(), count, scan_op, static_cast<uint32_t>(search_value), chunk_id,
+                   static_cast<ChunkOffset>(block_begin), pos_list);
+      }
+    } else {
+      using Code = std::remove_const_t<std::remove_pointer_t<decltype(typed_attribute_vector.data())>>;
+      scan_codes(typed_attribute_vector.data() + begin, end - begin, scan_op, static_cast<Code>(search_value), chunk_id,
+                 begin, pos_list);
+    }
+  });
 }
 
-void full_scan(std::shared_ptr<const BaseAttributeVector> attribute_vector, PosList& pos_list, ChunkID chunk_id) {
-  scan_attribute_vector<ScanType::OpNotEquals>(attribute_vector, pos_list, INVALID_VALUE_ID, chunk_id);
+// Scans producing at least this share of the rows of an input chunk collect their positions in a RowIDBitmap. From
+// this share on, most containers of the bitmap are dense and need a single bit per input row.
+constexpr auto BITMAP_MIN_SELECTIVITY = 1.0 / 16;
+
+// Emits all positions in [begin, end) of a segment without looking at its data
+void full_scan(const ChunkOffset begin, const ChunkOffset end, PosList& pos_list, ChunkID chunk_id) {
+  pos_list.reserve(pos_list.size() + (end - begin));
+  for (auto offset = begin; offset < end; ++offset) {
+    pos_list.emplace_back(RowID{chunk_id, offset});
+  }
 }
 
 TableScan::TableScan(const std::shared_ptr<const AbstractOperator> in, ColumnID column_id, const ScanType scan_type,
@@ -72,6 +110,44 @@ ScanType TableScan::scan_type() const { return _scan_type; }
 
 const AllTypeVariant& TableScan::search_value() const { return _search_value; }
 
+const std::string TableScan::name() const { return "TableScan"; }
+
+const std::string TableScan::description() const {
+  auto stream = std::ostringstream{};
+  stream << name() << " ";
+  const auto input_table = _input_left->get_output();
+  if (input_table) {
+    stream << input_table->column_name(_column_id);
+  } else {
+    stream << "#" << _column_id;
+  }
+
+  switch (_scan_type) {
+    case ScanType::OpEquals:
+      stream << " = ";
+      break;
+    case ScanType::OpNotEquals:
+      stream << " != ";
+      break;
+    case ScanType::OpLessThan:
+      stream << " < ";
+      break;
+    case ScanType::OpLessThanEquals:
+      stream << " <= ";
+      break;
+    case ScanType::OpGreaterThan:
+      stream << " > ";
+      break;
+    case ScanType::OpGreaterThanEquals:
+      stream << " >= ";
+      break;
+  }
+  stream << _search_value;
+  return stream.str();
+}
+
+void TableScan::set_thread_count(const size_t thread_count) { _thread_count = thread_count; }
+
 std::shared_ptr<const Table> TableScan::_on_execute() {
   const auto& data_type = _input_table_left()->column_type(_column_id);
   auto impl = make_unique_by_data_type<BaseTableScanImpl, TableScanImpl>(data_type);
@@ -105,71 +181,236 @@ std::shared_ptr<const Table> TableScan::TableScanImpl<T>::_on_execute_internal(T
   // Throws an exception if the type of search_value does not match the column type
   const auto search_value = get<T>(outer._search_value);
   const auto input_table = outer._input_table_left();
-  auto pos_list = std::make_shared<PosList>();
-  std::shared_ptr<const Table> referenced_table = input_table;
+  const auto make_pos_list = [&] {
+    return outer._arena ? outer._arena->make_shared<PosList>() : std::make_shared<PosList>();
+  };
+  const auto input_reference_segment = [&](const ChunkID chunk_id) {
+    return std::dynamic_pointer_cast<const ReferenceSegment>(
+        input_table->get_chunk(chunk_id).get_segment(outer._column_id));
+  };
 
+  // Split the chunks into morsels. Chunks of ReferenceSegments are not split, since their positions cannot be accessed
+  // from an arbitrary offset. Those chunks are not larger than the chunks they reference anyway.
+  struct Morsel {
+    ChunkID chunk_id;
+    ChunkOffset begin;
+    ChunkOffset end;
+  };
+  std::vector<Morsel> morsels;
+  std::vector<size_t> chunk_first_morsels;
   for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
-    const auto& chunk = input_table->get_chunk(chunk_id);
-    const auto segment = chunk.get_segment(outer._column_id);
-    if (const auto value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(segment); value_segment != nullptr) {
-      _scan_value_segment<scan_op>(*pos_list, chunk_id, search_value, *value_segment);
-    } else if (const auto dictionary_segment = std::dynamic_pointer_cast<DictionarySegment<T>>(segment);
-               dictionary_segment != nullptr) {
-      _scan_dictionary_segment<scan_op>(*pos_list, chunk_id, search_value, *dictionary_segment);
-    } else if (const auto reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(segment);
-               reference_segment != nullptr) {
-      _scan_reference_segment<scan_op>(*pos_list, chunk_id, search_value, *reference_segment);
-      referenced_table = reference_segment->referenced_table();
+    chunk_first_morsels.emplace_back(morsels.size());
+    const size_t chunk_size = input_table->get_chunk(chunk_id).size();
+    const auto morsel_size = input_reference_segment(chunk_id) ? chunk_size : MORSEL_SIZE;
+    for (size_t begin = 0; begin < chunk_size; begin += morsel_size) {
+      morsels.emplace_back(Morsel{chunk_id, static_cast<ChunkOffset>(begin),
+                                  static_cast<ChunkOffset>(std::min(begin + morsel_size, chunk_size))});
     }
   }
+  chunk_first_morsels.emplace_back(morsels.size());
+
+  // Each morsel is scanned into its own PosList. The matches of a chunk are then concatenated in the order of its
+  // morsels, so that the result does not depend on the number of threads. Morsels of a table that select many of their
+  // rows keep their matches as one bit per row instead, from which a RowIDBitmap is built. Thus, the positions of a
+  // selective scan are never held as a PosList of 8 bytes per match, except for the morsels being scanned.
+  std::vector<std::shared_ptr<PosList>> morsel_pos_lists(morsels.size());
+  std::vector<std::vector<uint64_t>> morsel_match_bits(morsels.size());
+  std::vector<size_t> morsel_match_counts(morsels.size());
+  run_in_parallel(morsels.size(), outer._thread_count, [&](const size_t morsel_index) {
+    const auto& morsel = morsels[morsel_index];
+    const auto& chunk = input_table->get_chunk(morsel.chunk_id);
+    if (input_reference_segment(morsel.chunk_id)) {
+      auto pos_list = make_pos_list();
+      _scan_chunk<scan_op>(*pos_list, morsel.chunk_id, morsel.begin, morsel.end, search_value, chunk, outer._column_id);
+      morsel_match_counts[morsel_index] = pos_list->size();
+      morsel_pos_lists[morsel_index] = std::move(pos_list);
+      return;
+    }
+
+    auto matches = PosList{};
+    _scan_chunk<scan_op>(matches, morsel.chunk_id, morsel.begin, morsel.end, search_value, chunk, outer._column_id);
+    morsel_match_counts[morsel_index] = matches.size();
+    if (matches.size() >= (morsel.end - morsel.begin) * BITMAP_MIN_SELECTIVITY) {
+      auto& match_bits = morsel_match_bits[morsel_index];
+      match_bits.resize((morsel.end - morsel.begin + 63) / 64);
+      for (const auto& row_id : matches) {
+        const auto bit = row_id.chunk_offset - morsel.begin;
+        match_bits[bit / 64] |= uint64_t{1} << (bit % 64);
+      }
+    } else {
+      auto pos_list = make_pos_list();
+      pos_list->assign(matches.begin(), matches.end());
+      morsel_pos_lists[morsel_index] = std::move(pos_list);
+    }
+  });
+
+  // calls functor(const RowID&) for the matches of a morsel in ascending order
+  const auto for_each_match = [&](const size_t morsel_index, const auto& functor) {
+    if (morsel_pos_lists[morsel_index]) {
+      for (const auto& row_id : *morsel_pos_lists[morsel_index]) functor(row_id);
+      return;
+    }
+    const auto& morsel = morsels[morsel_index];
+    const auto& match_bits = morsel_match_bits[morsel_index];
+    for (size_t word_index{0}; word_index < match_bits.size(); ++word_index) {
+      for (auto word = match_bits[word_index]; word != 0; word &= word - 1) {
+        const auto bit = static_cast<ChunkOffset>(word_index * 64 + __builtin_ctzll(word));
+        functor(RowID{morsel.chunk_id, morsel.begin + bit});
+      }
+    }
+  };
 
   auto result_table = std::make_shared<Table>();
-  Chunk result_chunk;
   for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
-    auto segment = std::make_shared<ReferenceSegment>(referenced_table, column_id, pos_list);
-    result_chunk.add_segment(segment);
     result_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
   }
 
-  result_table->emplace_chunk(std::move(result_chunk));
+  // Each input chunk with matches becomes an output chunk with its own positions, so that consumers can process the
+  // output chunks independently. Its positions are all in one chunk of the referenced table unless the input chunk
+  // references several chunks itself.
+  const auto emit_chunk = [&](const std::shared_ptr<const Table>& referenced_table,
+                              const std::shared_ptr<const PosList>& pos_list,
+                              const std::shared_ptr<const RowIDBitmap>& row_id_bitmap,
+                              const bool references_single_chunk) {
+    Chunk result_chunk;
+    for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
+      auto segment = row_id_bitmap ? std::make_shared<ReferenceSegment>(referenced_table, column_id, row_id_bitmap,
+                                                                        references_single_chunk)
+                                   : std::make_shared<ReferenceSegment>(referenced_table, column_id, pos_list,
+                                                                        references_single_chunk);
+      result_chunk.add_segment(segment);
+    }
+    result_table->emplace_chunk(std::move(result_chunk));
+  };
+
+  for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+    const auto first_morsel = chunk_first_morsels[chunk_id];
+    const auto last_morsel = chunk_first_morsels[chunk_id + 1];
+    if (first_morsel == last_morsel) continue;
+
+    auto match_count = size_t{0};
+    for (auto morsel = first_morsel; morsel < last_morsel; ++morsel) match_count += morsel_match_counts[morsel];
+    if (match_count == 0) continue;
+
+    // Positions in a table are found in ascending order, so they can be stored in a RowIDBitmap instead of a PosList
+    // if the scan selects many rows of the chunk. Positions found in a ReferenceSegment may be in any order.
+    const auto input_segment = input_reference_segment(chunk_id);
+    if (!input_segment && match_count >= input_table->get_chunk(chunk_id).size() * BITMAP_MIN_SELECTIVITY) {
+      auto row_id_bitmap = std::make_shared<RowIDBitmap>();
+      for (auto morsel = first_morsel; morsel < last_morsel; ++morsel) {
+        for_each_match(morsel, [&](const RowID& row_id) { row_id_bitmap->push_back(row_id); });
+        morsel_pos_lists[morsel] = nullptr;
+        morsel_match_bits[morsel] = {};
+      }
+      emit_chunk(input_table, nullptr, row_id_bitmap, true);
+      continue;
+    }
+
+    auto pos_list = morsel_pos_lists[first_morsel];
+    if (last_morsel - first_morsel > 1 || !pos_list) {
+      pos_list = make_pos_list();
+      pos_list->reserve(match_count);
+      for (auto morsel = first_morsel; morsel < last_morsel; ++morsel) {
+        for_each_match(morsel, [&](const RowID& row_id) { pos_list->emplace_back(row_id); });
+      }
+    }
+
+    if (input_segment) {
+      emit_chunk(input_segment->referenced_table(), pos_list, nullptr, input_segment->references_single_chunk());
+    } else {
+      emit_chunk(input_table, pos_list, nullptr, true);
+    }
+  }
+
+  // Operators consuming the result expect at least one chunk with all columns
+  if (result_table->row_count() == 0) {
+    const auto input_segment = input_reference_segment(ChunkID{0});
+    emit_chunk(input_segment ? input_segment->referenced_table() : input_table, make_pos_list(), nullptr, true);
+  }
   return result_table;
 }
 
 template <class T>
 template <ScanType scan_op>
-void TableScan::TableScanImpl<T>::_scan_value_segment(PosList& pos_list, ChunkID chunk_id, const T& search_value,
+void TableScan::TableScanImpl<T>::_scan_chunk(PosList& pos_list, ChunkID chunk_id, ChunkOffset begin, ChunkOffset end,
+                                              const T& search_value, const Chunk& chunk, ColumnID column_id) {
+  // The zone map of a segment may show that none or all of its rows match without looking at the data
+  if (const auto zone_map = std::static_pointer_cast<const ZoneMap<T>>(chunk.get_zone_map(column_id));
+      zone_map != nullptr) {
+    if (!zone_map->can_match(scan_op, search_value)) return;
+    if (zone_map->matches_all(scan_op, search_value)) {
+      full_scan(begin, end, pos_list, chunk_id);
+      return;
+    }
+  }
+
+  const auto segment = chunk.get_segment(column_id);
+  resolve_segment_type<T>(*segment, [&](const auto& typed_segment) {
+    using SegmentType = std::decay_t<decltype(typed_segment)>;
+    if constexpr (std::is_same_v<SegmentType, ValueSegment<T>>) {
+      _scan_value_segment<scan_op>(pos_list, chunk_id, begin, end, search_value, typed_segment);
+    } else if constexpr (std::is_same_v<SegmentType, DictionarySegment<T>>) {
+      _scan_dictionary_segment<scan_op>(pos_list, chunk_id, begin, end, search_value, typed_segment);
+    } else if constexpr (std::is_same_v<SegmentType, RunLengthSegment<T>>) {
+      _scan_run_length_segment<scan_op>(pos_list, chunk_id, begin, end, search_value, typed_segment);
+    } else if constexpr (std::is_same_v<SegmentType, FrameOfReferenceSegment<T>>) {
+      _scan_frame_of_reference_segment<scan_op>(pos_list, chunk_id, begin, end, search_value, typed_segment);
+    } else {
+      DebugAssert(begin == 0 && end == typed_segment.size(), "ReferenceSegments can only be scanned as a whole");
+      _scan_reference_segment<scan_op>(pos_list, chunk_id, search_value, typed_segment);
+    }
+  });
+}
+
+template <class T>
+template <ScanType scan_op>
+void TableScan::TableScanImpl<T>::_scan_value_segment(PosList& pos_list, ChunkID chunk_id, ChunkOffset begin,
+                                                      ChunkOffset end, const T& search_value,
                                                       const ValueSegment<T>& segment) {
   const auto& data = segment.values();
-  scan_vector<scan_op>(data, pos_list, search_value, chunk_id);
+  scan_vector<scan_op>(data, pos_list, search_value_view(search_value), chunk_id, begin, end);
 }
 
 template <class T>
 template <ScanType scan_op>
-void TableScan::TableScanImpl<T>::_scan_dictionary_segment(PosList& pos_list, ChunkID chunk_id, const T& search_value,
+void TableScan::TableScanImpl<T>::_scan_dictionary_segment(PosList& pos_list, ChunkID chunk_id, ChunkOffset begin,
+                                                           ChunkOffset end, const T& search_value,
                                                            const DictionarySegment<T>& segment) {
+  // The membership filter rules out most values that are not in the dictionary with a single cache miss
+  if constexpr (scan_op == ScanType::OpEquals || scan_op == ScanType::OpNotEquals) {
+    const auto membership_filter = segment.membership_filter();
+    if (membership_filter && !membership_filter->may_contain(search_value)) {
+      if constexpr (scan_op == ScanType::OpNotEquals) {
+        full_scan(begin, end, pos_list, chunk_id);
+      }
+      return;
+    }
+  }
+
   auto search_value_id = segment.lower_bound(search_value);
   const auto attribute_vector = segment.attribute_vector();
 
   if (search_value_id == INVALID_VALUE_ID) {
     if constexpr (scan_op == ScanType::OpLessThanEquals || scan_op == ScanType::OpLessThan ||
                   scan_op == ScanType::OpNotEquals) {
-      full_scan(attribute_vector, pos_list, chunk_id);
+      full_scan(begin, end, pos_list, chunk_id);
     }
 
     return;
   }
 
   if constexpr (scan_op == ScanType::OpGreaterThanEquals || scan_op == ScanType::OpLessThan) {
-    scan_attribute_vector<scan_op>(attribute_vector, pos_list, search_value_id, chunk_id);
-  } else if (segment.value_by_value_id(search_value_id) == search_value) {
-    scan_attribute_vector<scan_op>(attribute_vector, pos_list, search_value_id, chunk_id);
+    scan_attribute_vector<scan_op>(attribute_vector, pos_list, search_value_id, chunk_id, begin, end);
+  } else if (segment.value_by_value_id(search_value_id) == search_value_view(search_value)) {
+    scan_attribute_vector<scan_op>(attribute_vector, pos_list, search_value_id, chunk_id, begin, end);
   } else {
     if constexpr (scan_op == ScanType::OpNotEquals) {
-      full_scan(attribute_vector, pos_list, chunk_id);
+      full_scan(begin, end, pos_list, chunk_id);
     } else if constexpr (scan_op == ScanType::OpGreaterThan) {
-      scan_attribute_vector<ScanType::OpGreaterThanEquals>(attribute_vector, pos_list, search_value_id, chunk_id);
+      scan_attribute_vector<ScanType::OpGreaterThanEquals>(attribute_vector, pos_list, search_value_id, chunk_id, begin,
+                                                           end);
     } else if constexpr (scan_op == ScanType::OpLessThanEquals) {
-      scan_attribute_vector<ScanType::OpLessThan>(attribute_vector, pos_list, search_value_id, chunk_id);
+      scan_attribute_vector<ScanType::OpLessThan>(attribute_vector, pos_list, search_value_id, chunk_id, begin, end);
     }
     // Operator == and element not in dictionary -> no matching values
   }
@@ -177,62 +418,80 @@ void TableScan::TableScanImpl<T>::_scan_dictionary_segment(PosList& pos_list, Ch
 
 template <class T>
 template <ScanType scan_op>
-void TableScan::TableScanImpl<T>::_scan_reference_segment(PosList& pos_list, ChunkID _chunk_id, const T& search_value,
-                                                          const ReferenceSegment& segment) {
-  const auto& table = *segment.referenced_table();
-  const auto compare = comparator<T, scan_op>();
-  const auto& input_pos_list = *segment.pos_list();
-
-  // Heuristic to fall back to virtual operator[] call for each element for small
-  // ReferenceSegments to avoid dynamic_casts and allocation of vectors. A more
-  // optimal cutoff point could be determined by benchmarking.
-  if (input_pos_list.size() < 5 * table.chunk_count()) {
-    for (const auto& row_id : input_pos_list) {
-      const auto& chunk = table.get_chunk(row_id.chunk_id);
-      const auto& referenced_segment = *chunk.get_segment(segment.referenced_column_id());
-
-      if (compare(type_cast<T>(referenced_segment[row_id.chunk_offset]), search_value)) {
-        pos_list.emplace_back(row_id);
+void TableScan::TableScanImpl<T>::_scan_run_length_segment(PosList& pos_list, ChunkID chunk_id, ChunkOffset begin,
+                                                           ChunkOffset end, const T& search_value,
+                                                           const RunLengthSegment<T>& segment) {
+  // Each run is compared only once. If it matches, all of its positions are emitted without touching the data again.
+  const auto compare = comparator<scan_op>();
+  const auto& values = segment.values();
+  const auto& end_positions = segment.end_positions();
+
+  // The first run overlapping [begin, end) is the first one ending after begin
+  auto run = static_cast<size_t>(std::upper_bound(end_positions.begin(), end_positions.end(), begin) -
+                                 end_positions.begin());
+  auto run_begin = run == 0 ? ChunkOffset{0} : end_positions[run - 1];
+  for (; run < values.size() && run_begin < end; ++run) {
+    const ChunkOffset run_end = end_positions[run];
+    if (compare(values[run], search_value)) {
+      for (auto offset = std::max(run_begin, begin); offset < std::min(run_end, end); ++offset) {
+        pos_list.emplace_back(RowID{chunk_id, offset});
       }
     }
-  } else {
-    // Determine types of all segments beforehand, to allow inlining and other optimizations
-    // not possible when using virtual calls to operator[].
-    std::vector<std::shared_ptr<ValueSegment<T>>> value_segments;
-    std::vector<std::shared_ptr<DictionarySegment<T>>> dict_segments;
-    // Maps chunks in the referenced table to the two vectors above.
-    // The initial bool is true if the segment is a value segment.
-    std::vector<std::pair<bool, size_t>> segment_mapping;
-
-    for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
-      const auto& referenced_chunk = table.get_chunk(chunk_id);
-      const auto referenced_segment = referenced_chunk.get_segment(segment.referenced_column_id());
-
-      if (const auto referenced_value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(referenced_segment);
-          referenced_value_segment != nullptr) {
-        segment_mapping.emplace_back(true, value_segments.size());
-        value_segments.emplace_back(move(referenced_value_segment));
-      } else if (const auto referenced_dict_segment =
-                     std::dynamic_pointer_cast<DictionarySegment<T>>(referenced_segment);
-                 referenced_dict_segment != nullptr) {
-        segment_mapping.emplace_back(false, dict_segments.size());
-        dict_segments.emplace_back(move(referenced_dict_segment));
-      } else {
-        Fail("only ValueSegment and DictionarySegment may be referenced by a ReferenceSegment");
+    run_begin = run_end;
+  }
+}
+
+template <class T>
+template <ScanType scan_op>
+void TableScan::TableScanImpl<T>::_scan_frame_of_reference_segment(PosList& pos_list, ChunkID chunk_id,
+                                                                   ChunkOffset begin, ChunkOffset end,
+                                                                   const T& search_value,
+                                                                   const FrameOfReferenceSegment<T>& segment) {
+  if constexpr (std::is_integral_v<T>) {
+    // The search value is rewritten into an offset from the minimum, so the offsets can be compared directly by the
+    // same kernels as the value ids of a dictionary segment. Search values outside of the range of representable
+    // offsets match either all or none of the rows.
+    const auto offsets = segment.offsets();
+    const auto max_offset = (uint64_t{1} << offsets->bit_width()) - 1;
+
+    if (search_value < segment.minimum()) {
+      if constexpr (scan_op == ScanType::OpNotEquals || scan_op == ScanType::OpGreaterThan ||
+                    scan_op == ScanType::OpGreaterThanEquals) {
+        full_scan(begin, end, pos_list, chunk_id);
       }
+      return;
     }
 
-    for (const auto& row_id : input_pos_list) {
-      const auto& [is_value_segment, segment_idx] = segment_mapping[row_id.chunk_id];
-      auto value = is_value_segment ? value_segments[segment_idx]->values()[row_id.chunk_offset]
-                                    : dict_segments[segment_idx]->get(row_id.chunk_offset);
-      if (compare(value, search_value)) {
-        pos_list.emplace_back(row_id);
+    const auto search_offset = static_cast<uint64_t>(search_value) - static_cast<uint64_t>(segment.minimum());
+    if (search_offset > max_offset) {
+      if constexpr (scan_op == ScanType::OpNotEquals || scan_op == ScanType::OpLessThan ||
+                    scan_op == ScanType::OpLessThanEquals) {
+        full_scan(begin, end, pos_list, chunk_id);
       }
+      return;
     }
+
+    scan_attribute_vector<scan_op>(offsets, pos_list, ValueID{static_cast<uint32_t>(search_offset)}, chunk_id, begin,
+                                   end);
+  } else {
+    Fail("FrameOfReference encoding is only supported for integral types");
   }
 }
 
+template <class T>
+template <ScanType scan_op>
+void TableScan::TableScanImpl<T>::_scan_reference_segment(PosList& pos_list, ChunkID, const T& search_value,
+                                                          const ReferenceSegment& segment) {
+  // The iterable resolves the type of each referenced segment once, so that the values are compared in inlined loops
+  const auto compare = comparator<scan_op>();
+  const auto search_view = search_value_view(search_value);
+  ReferenceSegmentIterable<T>{segment}.for_each_referenced([&](const auto& value, const RowID& row_id) {
+    if (compare(value, search_view)) {
+      pos_list.emplace_back(row_id);
+    }
+  });
+}
+
 EXPLICITLY_INSTANTIATE_DATA_TYPES(TableScan::TableScanImpl);
 
 }  // namespace opossum
@@ -8,7 +8,9 @@
 #include "abstract_operator.hpp"
 #include "all_type_variant.hpp"
 #include "storage/dictionary_segment.hpp"
+#include "storage/frame_of_reference_segment.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/run_length_segment.hpp"
 #include "storage/table.hpp"
 #include "storage/value_segment.hpp"
 #include "type_cast.hpp"
@@ -31,6 +33,16 @@ class TableScan : public AbstractOperator {
   ScanType scan_type() const;
   const AllTypeVariant& search_value() const;
 
+  const std::string name() const override;
+
+  // e.g., "TableScan a > 5". The column is given by its id if the input was not executed yet.
+  const std::string description() const override;
+
+  // Makes the scan use up to thread_count threads. The input is split into morsels of whole chunks, or parts of large
+  // chunks, which the threads take one after another. The result is the same as that of a scan using a single thread,
+  // which is the default. Must be called before execute().
+  void set_thread_count(size_t thread_count);
+
  protected:
   std::shared_ptr<const Table> _on_execute() override;
 
@@ -44,13 +56,26 @@ class TableScan : public AbstractOperator {
   template <class T>
   class TableScanImpl : public BaseTableScanImpl {
    private:
+    // Scans the rows [begin, end) of a chunk of the input table. Chunks of ReferenceSegments are scanned as a whole.
+    template <ScanType scan_op>
+    void _scan_chunk(PosList& pos_list, ChunkID chunk_id, ChunkOffset begin, ChunkOffset end, const T& search_value,
+                     const Chunk& chunk, ColumnID column_id);
+
+    template <ScanType scan_op>
+    void _scan_value_segment(PosList& pos_list, ChunkID chunk_id, ChunkOffset begin, ChunkOffset end,
+                             const T& search_value, const ValueSegment<T>& segment);
+
+    template <ScanType scan_op>
+    void _scan_dictionary_segment(PosList& pos_list, ChunkID chunk_id, ChunkOffset begin, ChunkOffset end,
+                                  const T& search_value, const DictionarySegment<T>& segment);
+
     template <ScanType scan_op>
-    void _scan_value_segment(PosList& pos_list, ChunkID chunk_id, const T& search_value,
-                             const ValueSegment<T>& segment);
+    void _scan_run_length_segment(PosList& pos_list, ChunkID chunk_id, ChunkOffset begin, ChunkOffset end,
+                                  const T& search_value, const RunLengthSegment<T>& segment);
 
     template <ScanType scan_op>
-    void _scan_dictionary_segment(PosList& pos_list, ChunkID chunk_id, const T& search_value,
-                                  const DictionarySegment<T>& segment);
+    void _scan_frame_of_reference_segment(PosList& pos_list, ChunkID chunk_id, ChunkOffset begin, ChunkOffset end,
+                                          const T& search_value, const FrameOfReferenceSegment<T>& segment);
 
     template <ScanType scan_op>
     void _scan_reference_segment(PosList& pos_list, ChunkID chunk_id, const T& search_value,
@@ -66,6 +91,7 @@ class TableScan : public AbstractOperator {
   ColumnID _column_id;
   ScanType _scan_type;
   AllTypeVariant _search_value;
+  size_t _thread_count{1};
 };
 
 }  // namespace opossum
@@ -0,0 +1,72 @@
+#include "abstract_task.hpp"
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+void AbstractTask::set_as_predecessor_of(const std::shared_ptr<AbstractTask>& successor) {
+  DebugAssert(successor.get() != this, "A task cannot be its own predecessor");
+  _successors.emplace_back(successor);
+  ++successor->_pending_predecessor_count;
+}
+
+const std::vector<std::shared_ptr<AbstractTask>>& AbstractTask::successors() const { return _successors; }
+
+bool AbstractTask::is_ready() const { return _pending_predecessor_count == 0; }
+
+bool AbstractTask::is_done() const {
+  auto guard = std::lock_guard{_mutex};
+  return _done;
+}
+
+void AbstractTask::join() {
+  auto lock = std::unique_lock{_mutex};
+  _done_condition.wait(lock, [&] { return _done; });
+
+  if (_exception) {
+    std::rethrow_exception(_exception);
+  }
+}
+
+std::vector<std::shared_ptr<AbstractTask>> AbstractTask::execute() {
+  DebugAssert(is_ready(), "Task executed before its predecessors are done");
+  auto exception = std::exception_ptr{};
+  {
+    auto guard = std::lock_guard{_mutex};
+    DebugAssert(!_done, "Task executed twice");
+    exception = _exception;
+  }
+
+  // A failed predecessor has passed its exception on to this task already
+  if (!exception) {
+    try {
+      _on_execute();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+  }
+
+  {
+    auto guard = std::lock_guard{_mutex};
+    _exception = exception;
+    _done = true;
+  }
+  _done_condition.notify_all();
+
+  std::vector<std::shared_ptr<AbstractTask>> ready_successors;
+  for (const auto& successor : _successors) {
+    if (exception) {
+      auto guard = std::lock_guard{successor->_mutex};
+      if (!successor->_exception) successor->_exception = exception;
+    }
+    if (--successor->_pending_predecessor_count == 0) ready_successors.emplace_back(successor);
+  }
+  return ready_successors;
+}
+
+}  // namespace opossum
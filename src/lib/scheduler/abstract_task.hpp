@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// AbstractTask is a unit of work that is executed by a NodeQueueScheduler. Tasks form a directed acyclic graph: a task
+// is executed only after all of its predecessors are done. If a task throws an exception, its successors are not
+// executed, but they are done and rethrow the exception in join().
+class AbstractTask : private Noncopyable {
+ public:
+  virtual ~AbstractTask() = default;
+
+  // Makes this task a predecessor of the given task. Must be called before either task is scheduled.
+  void set_as_predecessor_of(const std::shared_ptr<AbstractTask>& successor);
+
+  const std::vector<std::shared_ptr<AbstractTask>>& successors() const;
+
+  // returns true if the task has no predecessors that are not done yet
+  bool is_ready() const;
+
+  bool is_done() const;
+
+  // Blocks until the task is done. Rethrows the exception thrown by the task or one of its predecessors, if any.
+  void join();
+
+  // Executes the task in the calling thread, which is usually a worker of the scheduler, and marks it as done. Returns
+  // the successors that became ready, which the caller has to execute next.
+  std::vector<std::shared_ptr<AbstractTask>> execute();
+
+ protected:
+  virtual void _on_execute() = 0;
+
+  std::vector<std::shared_ptr<AbstractTask>> _successors;
+  std::atomic<size_t> _pending_predecessor_count{0};
+
+  // The following members are protected by _mutex
+  mutable std::mutex _mutex;
+  bool _done{false};
+  std::exception_ptr _exception;
+
+  // Signalled when the task is done
+  std::condition_variable _done_condition;
+};
+
+}  // namespace opossum
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <functional>
+
+#include "abstract_task.hpp"
+
+namespace opossum {
+
+// A task that calls an arbitrary function
+class JobTask : public AbstractTask {
+ public:
+  explicit JobTask(std::function<void()> function);
+
+ protected:
+  void _on_execute() override;
+
+  const std::function<void()> _function;
+};
+
+}  // namespace opossum
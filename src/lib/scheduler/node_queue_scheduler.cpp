@@ -0,0 +1,148 @@
+#include "node_queue_scheduler.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+NodeQueueScheduler::NodeQueueScheduler(const size_t worker_count, const bool pin_workers) {
+  Assert(worker_count > 0, "NodeQueueScheduler needs at least one worker");
+
+  std::vector<int> cpus;
+  if (pin_workers) {
+    cpu_set_t allowed_cpus;
+    Assert(sched_getaffinity(0, sizeof(allowed_cpus), &allowed_cpus) == 0, "Could not get the CPUs of the process");
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &allowed_cpus)) cpus.emplace_back(cpu);
+    }
+  }
+
+  for (size_t worker_id{0}; worker_id < worker_count; ++worker_id) {
+    _workers.emplace_back(std::make_unique<Worker>());
+  }
+  for (size_t worker_id{0}; worker_id < worker_count; ++worker_id) {
+    auto& thread = _workers[worker_id]->thread;
+    thread = std::thread{[this, worker_id] { _work(worker_id); }};
+
+    if (!cpus.empty()) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(cpus[worker_id % cpus.size()], &cpu_set);
+      Assert(pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set) == 0,
+             "Could not pin worker to CPU");
+    }
+  }
+}
+
+NodeQueueScheduler::~NodeQueueScheduler() {
+  wait_for_all_tasks();
+  {
+    auto guard = std::lock_guard{_mutex};
+    _shutdown = true;
+  }
+  _work_available.notify_all();
+  for (auto& worker : _workers) worker->thread.join();
+}
+
+void NodeQueueScheduler::schedule(const std::vector<std::shared_ptr<AbstractTask>>& tasks) {
+  // The roots are determined before any of them is enqueued, since the workers start executing them right away and
+  // their successors become ready meanwhile
+  std::vector<std::shared_ptr<AbstractTask>> ready_tasks;
+  for (const auto& task : tasks) {
+    if (task->is_ready()) ready_tasks.emplace_back(task);
+  }
+  for (const auto& task : ready_tasks) {
+    _enqueue(_next_worker_id++ % _workers.size(), task);
+  }
+}
+
+void NodeQueueScheduler::schedule_and_wait(const std::vector<std::shared_ptr<AbstractTask>>& tasks) {
+  schedule(tasks);
+
+  auto exception = std::exception_ptr{};
+  for (const auto& task : tasks) {
+    try {
+      task->join();
+    } catch (...) {
+      if (!exception) exception = std::current_exception();
+    }
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void NodeQueueScheduler::wait_for_all_tasks() {
+  auto lock = std::unique_lock{_mutex};
+  _idle.wait(lock, [&] { return _unfinished_task_count == 0; });
+}
+
+size_t NodeQueueScheduler::worker_count() const { return _workers.size(); }
+
+void NodeQueueScheduler::_work(const size_t worker_id) {
+  while (true) {
+    const auto task = _dequeue(worker_id);
+    if (!task) {
+      auto lock = std::unique_lock{_mutex};
+      _work_available.wait(lock, [&] { return _shutdown || _queued_task_count > 0; });
+      if (_shutdown) return;
+      continue;
+    }
+
+    // Successors are put into the worker's own queue, so that it executes them next
+    for (const auto& successor : task->execute()) _enqueue(worker_id, successor);
+
+    auto guard = std::lock_guard{_mutex};
+    if (--_unfinished_task_count == 0) _idle.notify_all();
+  }
+}
+
+void NodeQueueScheduler::_enqueue(const size_t worker_id, const std::shared_ptr<AbstractTask>& task) {
+  // The task is counted first, so that the count never drops below the number of tasks in the queues
+  {
+    auto guard = std::lock_guard{_mutex};
+    ++_queued_task_count;
+    ++_unfinished_task_count;
+  }
+  {
+    auto& worker = *_workers[worker_id];
+    auto guard = std::lock_guard{worker.mutex};
+    worker.queue.emplace_back(task);
+  }
+  _work_available.notify_one();
+}
+
+std::shared_ptr<AbstractTask> NodeQueueScheduler::_dequeue(const size_t worker_id) {
+  auto task = std::shared_ptr<AbstractTask>{};
+  for (size_t offset{0}; offset < _workers.size() && !task; ++offset) {
+    auto& worker = *_workers[(worker_id + offset) % _workers.size()];
+    auto guard = std::lock_guard{worker.mutex};
+    if (worker.queue.empty()) continue;
+
+    if (offset == 0) {
+      task = std::move(worker.queue.back());
+      worker.queue.pop_back();
+    } else {
+      task = std::move(worker.queue.front());
+      worker.queue.pop_front();
+    }
+  }
+
+  if (task) {
+    auto guard = std::lock_guard{_mutex};
+    --_queued_task_count;
+  }
+  return task;
+}
+
+}  // namespace opossum
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "abstract_task.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// The NodeQueueScheduler executes graphs of tasks, e.g., the operators of a query (see OperatorTask), on a fixed set
+// of worker threads. Each worker owns a queue of ready tasks. It executes the tasks of its own queue in LIFO order, so
+// that a successor becoming ready is usually executed right after its predecessor by the same worker, while its input
+// is still in the cache. Workers whose queue is empty steal the oldest tasks from the queues of other workers. Thus,
+// independent subtrees of a graph are executed concurrently.
+//
+// Unlike Hyrise's scheduler of the same name, the workers are not grouped into queues per NUMA node. There is one
+// queue per worker instead.
+class NodeQueueScheduler : private Noncopyable {
+ public:
+  // If pin_workers is set, each worker is pinned to a core of those the process may run on, round robin
+  explicit NodeQueueScheduler(size_t worker_count = std::max(1u, std::thread::hardware_concurrency()),
+                              bool pin_workers = false);
+
+  // Waits until all scheduled tasks are done and stops the workers
+  ~NodeQueueScheduler();
+
+  // Schedules a graph of tasks. The tasks without predecessors are distributed among the workers. All other tasks are
+  // executed once their last predecessor is done, so all tasks of a graph have to be scheduled at once. This is
+  // thread-safe.
+  void schedule(const std::vector<std::shared_ptr<AbstractTask>>& tasks);
+
+  // Schedules a graph of tasks and waits until all of them are done. Rethrows the first exception thrown by a task.
+  void schedule_and_wait(const std::vector<std::shared_ptr<AbstractTask>>& tasks);
+
+  // Blocks until all tasks scheduled so far are done
+  void wait_for_all_tasks();
+
+  size_t worker_count() const;
+
+ protected:
+  struct Worker {
+    std::thread thread;
+    std::mutex mutex;
+    std::deque<std::shared_ptr<AbstractTask>> queue;
+  };
+
+  void _work(size_t worker_id);
+
+  // adds a ready task to the queue of the given worker
+  void _enqueue(size_t worker_id, const std::shared_ptr<AbstractTask>& task);
+
+  // takes the newest task of the worker's own queue or, if it is empty, steals the oldest task of another queue
+  std::shared_ptr<AbstractTask> _dequeue(size_t worker_id);
+
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::atomic<size_t> _next_worker_id{0};
+
+  // The following members are protected by _mutex
+  std::mutex _mutex;
+  size_t _queued_task_count{0};
+  size_t _unfinished_task_count{0};
+  bool _shutdown{false};
+
+  // Signalled when a task is enqueued or the scheduler shuts down
+  std::condition_variable _work_available;
+  // Signalled when the last unfinished task is done
+  std::condition_variable _idle;
+};
+
+}  // namespace opossum
@@ -0,0 +1,47 @@
+#include "operator_task.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "operators/abstract_operator.hpp"
+
+namespace opossum {
+
+OperatorTask::OperatorTask(std::shared_ptr<AbstractOperator> op) : _op{std::move(op)} {}
+
+std::vector<std::shared_ptr<AbstractTask>> OperatorTask::make_tasks_from_operator(
+    const std::shared_ptr<AbstractOperator>& op) {
+  std::vector<std::shared_ptr<AbstractTask>> tasks;
+  std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractTask>> task_by_operator;
+
+  // Creates the tasks of the inputs before the task of the operator itself, so that inputs come first in tasks
+  const auto add_tasks = [&](const auto& self, const std::shared_ptr<AbstractOperator>& current_op)
+      -> std::shared_ptr<AbstractTask> {
+    if (!current_op || current_op->get_output()) return nullptr;
+    const auto iter = task_by_operator.find(current_op.get());
+    if (iter != task_by_operator.end()) return iter->second;
+
+    // Operators only expose their inputs as const, since executing the operator does not modify them. Executing the
+    // inputs themselves is what the tasks are for.
+    const auto left_task = self(self, std::const_pointer_cast<AbstractOperator>(current_op->input_left()));
+    const auto right_task = self(self, std::const_pointer_cast<AbstractOperator>(current_op->input_right()));
+
+    auto task = std::make_shared<OperatorTask>(current_op);
+    if (left_task) left_task->set_as_predecessor_of(task);
+    if (right_task && right_task != left_task) right_task->set_as_predecessor_of(task);
+    task_by_operator.emplace(current_op.get(), task);
+    tasks.emplace_back(task);
+    return task;
+  };
+  add_tasks(add_tasks, op);
+
+  return tasks;
+}
+
+const std::shared_ptr<AbstractOperator>& OperatorTask::get_operator() const { return _op; }
+
+void OperatorTask::_on_execute() { _op->execute(); }
+
+}  // namespace opossum
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_task.hpp"
+
+namespace opossum {
+
+class AbstractOperator;
+
+// A task that executes an operator
+class OperatorTask : public AbstractTask {
+ public:
+  explicit OperatorTask(std::shared_ptr<AbstractOperator> op);
+
+  // Creates a task for the operator and for each of its direct and indirect inputs that was not executed yet. The task
+  // of each input is a predecessor of the tasks of the operators consuming it, so that independent inputs may be
+  // executed concurrently. Inputs shared by several operators get a single task. The task of the given operator is
+  // the last one.
+  static std::vector<std::shared_ptr<AbstractTask>> make_tasks_from_operator(
+      const std::shared_ptr<AbstractOperator>& op);
+
+  const std::shared_ptr<AbstractOperator>& get_operator() const;
+
+ protected:
+  void _on_execute() override;
+
+  const std::shared_ptr<AbstractOperator> _op;
+};
+
+}  // namespace opossum
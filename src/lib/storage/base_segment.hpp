@@ -28,5 +28,9 @@ class BaseSegment : private Noncopyable {
 
   // returns the number of values
   virtual size_t size() const = 0;
+
+  // returns the number of bytes used by the segment, including the memory allocated on the heap. Data structures
+  // shared with other segments, such as referenced segments, are not included.
+  virtual size_t estimate_memory_usage() const = 0;
 };
 }  // namespace opossum
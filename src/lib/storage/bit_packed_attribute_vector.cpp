@@ -0,0 +1,95 @@
+#include "bit_packed_attribute_vector.hpp"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// A code starts at bit (bit_position % 8) of the byte it begins in. Since codes are at most 32 bits wide, reading the
+// eight bytes starting at that byte always covers the entire code.
+uint64_t load_bytes(const uint64_t* words, const size_t bit_position) {
+  uint64_t bytes;
+  std::memcpy(&bytes, reinterpret_cast<const char*>(words) + bit_position / 8, sizeof(bytes));
+  return bytes;
+}
+
+}  // namespace
+
+BitPackedAttributeVector::BitPackedAttributeVector(size_t size, uint8_t bit_width,
+                                                   std::pmr::memory_resource* memory_resource)
+    : _size{size},
+      _bit_width{bit_width},
+      _mask{(uint64_t{1} << bit_width) - 1},
+      _owned_words(word_count(size, bit_width), memory_resource),
+      _words{_owned_words.data()} {
+  DebugAssert(bit_width >= 1 && bit_width <= 32, "Bit width has to be between 1 and 32");
+}
+
+BitPackedAttributeVector::BitPackedAttributeVector(size_t size, uint8_t bit_width, const uint64_t* words,
+                                                   std::shared_ptr<const void> owner)
+    : _size{size},
+      _bit_width{bit_width},
+      _mask{(uint64_t{1} << bit_width) - 1},
+      _words{words},
+      _owner{std::move(owner)} {
+  DebugAssert(bit_width >= 1 && bit_width <= 32, "Bit width has to be between 1 and 32");
+}
+
+ValueID BitPackedAttributeVector::get(const size_t i) const {
+  DebugAssert(i < _size, "Position out of range");
+  const auto bit_position = i * _bit_width;
+  return ValueID{static_cast<uint32_t>((load_bytes(_words, bit_position) >> (bit_position % 8)) & _mask)};
+}
+
+void BitPackedAttributeVector::set(const size_t i, const ValueID value_id) {
+  DebugAssert(i < _size, "Position out of range");
+  DebugAssert(static_cast<uint64_t>(value_id) <= _mask, "Value id out of range for bit width");
+  // The words are only copied to _owned_words if they are not referenced
+  Assert(_words == _owned_words.data(), "Referenced attribute vectors are read-only");
+
+  const auto bit_position = i * _bit_width;
+  const auto shift = bit_position % 8;
+  auto bytes = load_bytes(_words, bit_position);
+  bytes = (bytes & ~(_mask << shift)) | (static_cast<uint64_t>(value_id) << shift);
+  std::memcpy(reinterpret_cast<char*>(_owned_words.data()) + bit_position / 8, &bytes, sizeof(bytes));
+}
+
+size_t BitPackedAttributeVector::size() const { return _size; }
+
+AttributeVectorWidth BitPackedAttributeVector::width() const { return (_bit_width + 7) / 8; }
+
+size_t BitPackedAttributeVector::estimate_memory_usage() const {
+  // Referenced words are counted as well, since they are part of the table's data even if they are mapped pages
+  return sizeof(*this) + word_count(_size, _bit_width) * sizeof(uint64_t);
+}
+
+const uint64_t* BitPackedAttributeVector::words() const { return _words; }
+
+size_t BitPackedAttributeVector::word_count(const size_t size, const uint8_t bit_width) {
+  return size * bit_width / 64 + 2;
+}
+
+uint8_t BitPackedAttributeVector::bit_width() const { return _bit_width; }
+
+void BitPackedAttributeVector::decode(size_t begin, size_t count, uint32_t* codes) const {
+  DebugAssert(begin + count <= _size, "Range out of bounds");
+
+  auto bit_position = begin * _bit_width;
+  for (size_t index = 0; index < count; ++index) {
+    codes[index] = static_cast<uint32_t>((load_bytes(_words, bit_position) >> (bit_position % 8)) & _mask);
+    bit_position += _bit_width;
+  }
+}
+
+uint8_t BitPackedAttributeVector::required_bit_width(uint32_t max_value_id) {
+  if (max_value_id == 0) return 1;
+  return static_cast<uint8_t>(32 - __builtin_clz(max_value_id));
+}
+
+}  // namespace opossum
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>  // NOLINT(build/include_order)
+#include <vector>
+
+#include "base_attribute_vector.hpp"
+
+namespace opossum {
+
+// BitPackedAttributeVector stores value ids with an arbitrary width of 1 to 32 bits. The codes are packed back to back
+// without padding, so a single code may span two 64 bit words. This assumes a little-endian architecture.
+class BitPackedAttributeVector : public BaseAttributeVector {
+ public:
+  // creates an attribute vector of the given size, allocated from the given memory resource
+  BitPackedAttributeVector(size_t size, uint8_t bit_width,
+                           std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource());
+
+  // Creates a read-only attribute vector that references the packed words at `words` without copying them, e.g., in
+  // a memory-mapped file. The memory has to stay valid as long as `owner` is alive. See word_count() for the number
+  // of words. Calling set() throws.
+  BitPackedAttributeVector(size_t size, uint8_t bit_width, const uint64_t* words, std::shared_ptr<const void> owner);
+
+  ValueID get(const size_t i) const override;
+
+  void set(const size_t i, const ValueID value_id) override;
+
+  size_t size() const override;
+
+  // returns the number of bytes needed to store a single code, rounded up
+  AttributeVectorWidth width() const override;
+
+  size_t estimate_memory_usage() const override;
+
+  // returns the number of bits used per code
+  uint8_t bit_width() const;
+
+  // Unpacks `count` codes starting at position `begin` into `codes`. Scans decode blocks of codes at once and then
+  // compare them with the scan kernels, which is much faster than calling get() for every position.
+  void decode(size_t begin, size_t count, uint32_t* codes) const;
+
+  // returns the packed codes
+  const uint64_t* words() const;
+
+  // returns the number of words needed for the given number of codes
+  static size_t word_count(size_t size, uint8_t bit_width);
+
+  // returns the number of bits needed to store value ids up to and including max_value_id (at least 1)
+  static uint8_t required_bit_width(uint32_t max_value_id);
+
+ private:
+  size_t _size;
+  uint8_t _bit_width;
+  uint64_t _mask;
+  // Contains one padding word, so that eight bytes can always be read starting at the byte of any code. Empty if the
+  // words are referenced.
+  std::pmr::vector<uint64_t> _owned_words;
+  const uint64_t* _words;
+  std::shared_ptr<const void> _owner;
+};
+
+}  // namespace opossum
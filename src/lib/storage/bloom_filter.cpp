@@ -0,0 +1,77 @@
+#include "bloom_filter.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Each value sets this many bits in its block. Six bits per value minimize the false positive rate for ten bits per
+// value in a blocked filter.
+constexpr auto BITS_SET_PER_VALUE = 6u;
+constexpr auto WORDS_PER_BLOCK = size_t{8};
+
+// The upper 32 bits of the hash select the block. The lower 32 bits are multiplied with an odd constant, whose upper
+// bits then select the bits within the block. A block has 512 bits, so nine bits are used for each of them.
+template <typename Function>
+void for_each_bit(const uint64_t hash, const size_t block_count, const Function& function) {
+  const auto block = static_cast<size_t>(((hash >> 32) * block_count) >> 32);
+  const auto bit_hash = (hash & 0xFFFFFFFF) * 0x9E3779B97F4A7C15ULL;
+  for (auto bit_index = 0u; bit_index < BITS_SET_PER_VALUE; ++bit_index) {
+    const auto bit = (bit_hash >> (64 - 9 * (bit_index + 1))) & 511;
+    function(block * WORDS_PER_BLOCK + bit / 64, uint64_t{1} << (bit % 64));
+  }
+}
+
+}  // namespace
+
+BloomFilter::BloomFilter(const size_t expected_count)
+    : _block_count{std::max(size_t{1}, (expected_count * BITS_PER_VALUE + 511) / 512)} {
+  _words.resize(_block_count * WORDS_PER_BLOCK);
+}
+
+BloomFilter::BloomFilter(std::vector<uint64_t> words)
+    : _words{std::move(words)}, _block_count{_words.size() / WORDS_PER_BLOCK} {
+  Assert(_block_count > 0 && _words.size() % WORDS_PER_BLOCK == 0, "Number of words does not match the block size");
+}
+
+size_t BloomFilter::byte_count() const { return _words.size() * sizeof(uint64_t); }
+
+const std::vector<uint64_t>& BloomFilter::words() const { return _words; }
+
+uint64_t BloomFilter::_hash_bytes(const char* data, const size_t size) {
+  auto hash = uint64_t{0xcbf29ce484222325ULL};
+  for (size_t index = 0; index < size; ++index) {
+    hash ^= static_cast<unsigned char>(data[index]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+uint64_t BloomFilter::_mix(uint64_t hash) {
+  // Finalizer of MurmurHash3
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+void BloomFilter::_insert_hash(const uint64_t hash) {
+  for_each_bit(hash, _block_count, [&](const size_t word, const uint64_t mask) { _words[word] |= mask; });
+}
+
+bool BloomFilter::_may_contain_hash(const uint64_t hash) const {
+  auto contained = true;
+  for_each_bit(hash, _block_count, [&](const size_t word, const uint64_t mask) {
+    contained &= (_words[word] & mask) != 0;
+  });
+  return contained;
+}
+
+}  // namespace opossum
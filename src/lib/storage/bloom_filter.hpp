@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <type_traits>
+#include <vector>
+
+namespace opossum {
+
+// BloomFilter is a probabilistic set of values. may_contain() never returns false for an inserted value, but returns
+// true for about 1% of the values that were not inserted.
+//
+// The filter is split into blocks of one cache line each. All bits of a value lie in the same block, so a lookup
+// touches a single cache line. This is considerably cheaper than a binary search over a large sorted dictionary.
+class BloomFilter {
+ public:
+  // Creates an empty filter with about BITS_PER_VALUE bits for each of `expected_count` values
+  explicit BloomFilter(size_t expected_count);
+
+  // Creates a filter from the words returned by words() of another filter
+  explicit BloomFilter(std::vector<uint64_t> words);
+
+  template <typename T>
+  void insert(const T& value) {
+    _insert_hash(_hash(value));
+  }
+
+  template <typename T>
+  bool may_contain(const T& value) const {
+    return _may_contain_hash(_hash(value));
+  }
+
+  // return the number of bytes used by the filter
+  size_t byte_count() const;
+
+  // return the bits of the filter
+  const std::vector<uint64_t>& words() const;
+
+  static constexpr size_t BITS_PER_VALUE = 10;
+
+ protected:
+  // The filters are written to disk by write_binary_table, so the hash must not depend on the standard library, unlike
+  // std::hash. Strings and std::string_views hash alike, which allows building filters from a StringHeap and probing
+  // them with std::strings. Floating-point numbers are hashed as doubles, with -0.0 hashed like 0.0.
+  template <typename T>
+  static uint64_t _hash(const T& value) {
+    if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+      return _mix(_hash_bytes(value.data(), value.size()));
+    } else {
+      if constexpr (std::is_floating_point_v<T>) {
+        const auto double_value = value == 0 ? 0.0 : static_cast<double>(value);
+        auto bits = uint64_t{0};
+        std::memcpy(&bits, &double_value, sizeof(bits));
+        return _mix(bits);
+      } else {
+        static_assert(std::is_integral_v<T>, "BloomFilter only supports numbers and strings");
+        return _mix(static_cast<uint64_t>(value));
+      }
+    }
+  }
+
+  // FNV-1a hash of a string
+  static uint64_t _hash_bytes(const char* data, size_t size);
+
+  // Integers are hashed as themselves, so the hash is mixed to spread it over all bits
+  static uint64_t _mix(uint64_t hash);
+
+  void _insert_hash(uint64_t hash);
+  bool _may_contain_hash(uint64_t hash) const;
+
+  std::vector<uint64_t> _words;
+  size_t _block_count;
+};
+
+}  // namespace opossum
@@ -4,17 +4,23 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "base_segment.hpp"
 #include "chunk.hpp"
+#include "reference_segment.hpp"
+#include "zone_map.hpp"
 
 #include "utils/assert.hpp"
 
 namespace opossum {
 
-void Chunk::add_segment(std::shared_ptr<BaseSegment> segment) { _segments.emplace_back(segment); }
+void Chunk::add_segment(std::shared_ptr<BaseSegment> segment) {
+  _segments.emplace_back(std::move(segment));
+  _zone_maps.emplace_back(nullptr);
+}
 
 void Chunk::append(const std::vector<AllTypeVariant>& values) {
   DebugAssert(values.size() == column_count(), "Number of passed arguments does not match number of columns");
@@ -24,7 +30,53 @@ void Chunk::append(const std::vector<AllTypeVariant>& values) {
   }
 }
 
-std::shared_ptr<BaseSegment> Chunk::get_segment(ColumnID column_id) const { return _segments[column_id]; }
+std::shared_ptr<BaseSegment> Chunk::get_segment(ColumnID column_id) const {
+  return std::atomic_load(&_segments[column_id]);
+}
+
+void Chunk::replace_segments(const std::vector<std::shared_ptr<BaseSegment>>& segments,
+                             const std::vector<std::shared_ptr<const BaseZoneMap>>& zone_maps) {
+  DebugAssert(segments.size() == column_count(), "Number of segments does not match number of columns");
+  // The zone maps are replaced first, since those of the old segments hold for the new ones as well
+  set_zone_maps(zone_maps);
+  for (ColumnID column_id{0}; column_id < segments.size(); ++column_id) {
+    std::atomic_store(&_segments[column_id], segments[column_id]);
+  }
+}
+
+void Chunk::set_zone_maps(const std::vector<std::shared_ptr<const BaseZoneMap>>& zone_maps) {
+  DebugAssert(zone_maps.size() == column_count(), "Number of zone maps does not match number of columns");
+  for (ColumnID column_id{0}; column_id < zone_maps.size(); ++column_id) {
+    std::atomic_store(&_zone_maps[column_id], zone_maps[column_id]);
+  }
+}
+
+std::shared_ptr<const BaseZoneMap> Chunk::get_zone_map(ColumnID column_id) const {
+  return std::atomic_load(&_zone_maps[column_id]);
+}
+
+size_t Chunk::estimate_memory_usage() const {
+  auto bytes = sizeof(*this) + _segments.capacity() * sizeof(std::shared_ptr<BaseSegment>) +
+               _zone_maps.capacity() * sizeof(std::shared_ptr<const BaseZoneMap>);
+
+  // The segments of a chunk created by TableScan all reference the same positions
+  auto counted_positions = std::unordered_set<const void*>{};
+  for (ColumnID column_id{0}; column_id < column_count(); ++column_id) {
+    const auto segment = get_segment(column_id);
+    bytes += segment->estimate_memory_usage();
+    if (const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(segment)) {
+      const auto positions = reference_segment->pos_list()
+                                 ? static_cast<const void*>(reference_segment->pos_list().get())
+                                 : static_cast<const void*>(reference_segment->row_id_bitmap().get());
+      if (!counted_positions.emplace(positions).second) bytes -= reference_segment->estimate_positions_memory_usage();
+    }
+  }
+
+  for (ColumnID column_id{0}; column_id < column_count(); ++column_id) {
+    if (const auto zone_map = get_zone_map(column_id)) bytes += zone_map->estimate_memory_usage();
+  }
+  return bytes;
+}
 
 uint16_t Chunk::column_count() const { return static_cast<uint16_t>(_segments.size()); }
 
@@ -15,6 +15,7 @@ namespace opossum {
 
 class BaseIndex;
 class BaseSegment;
+class BaseZoneMap;
 
 // A chunk is a horizontal partition of a table.
 // For each column in the table, it holds one segment. The segments across all chunks constitute the column.
@@ -42,11 +43,31 @@ class Chunk : private Noncopyable {
   // note this is slow and not thread-safe and should be used for testing purposes only
   void append(const std::vector<AllTypeVariant>& values);
 
-  // Returns the segment at a given position
+  // Returns the segment at a given position. The segments and zone maps are loaded and replaced atomically, so this
+  // can be called while replace_segments or set_zone_maps are called. The returned segment stays valid even if it is
+  // replaced meanwhile.
   std::shared_ptr<BaseSegment> get_segment(ColumnID column_id) const;
 
+  // Replaces the segments and zone maps of all columns, e.g., with encoded ones holding the same values. Readers may
+  // see the new segments of some columns and the old ones of others until this returns.
+  void replace_segments(const std::vector<std::shared_ptr<BaseSegment>>& segments,
+                        const std::vector<std::shared_ptr<const BaseZoneMap>>& zone_maps);
+
+  // sets the zone maps of all segments, which are built once the chunk no longer changes
+  void set_zone_maps(const std::vector<std::shared_ptr<const BaseZoneMap>>& zone_maps);
+
+  // Returns the zone map of the segment at a given position, or nullptr if no zone maps were built for this chunk
+  std::shared_ptr<const BaseZoneMap> get_zone_map(ColumnID column_id) const;
+
+  // Returns the number of bytes used by the chunk, i.e., by its segments and zone maps, see
+  // BaseSegment::estimate_memory_usage. Positions shared by multiple ReferenceSegments of the chunk are counted once.
+  size_t estimate_memory_usage() const;
+
  protected:
+  // Both have one entry per column, which is accessed using std::atomic_load and std::atomic_store. The vectors are
+  // only resized by add_segment, i.e., before the chunk is shared. Zone maps are nullptr until they are built.
   std::vector<std::shared_ptr<BaseSegment>> _segments;
+  std::vector<std::shared_ptr<const BaseZoneMap>> _zone_maps;
 };
 
 }  // namespace opossum
@@ -0,0 +1,74 @@
+#include "compression_service.hpp"
+
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+CompressionService::CompressionService(Table& table, const size_t worker_count, const EncodingType encoding_type)
+    : _table{table}, _encoding_type{encoding_type} {
+  Assert(worker_count > 0, "CompressionService needs at least one worker");
+  for (size_t worker_id{0}; worker_id < worker_count; ++worker_id) {
+    _workers.emplace_back([this] { _work(); });
+  }
+}
+
+CompressionService::~CompressionService() {
+  {
+    auto guard = std::lock_guard{_mutex};
+    _shutdown = true;
+    _queue.clear();
+  }
+  _work_available.notify_all();
+  for (auto& worker : _workers) worker.join();
+}
+
+void CompressionService::enqueue(const ChunkID chunk_id) {
+  {
+    auto guard = std::lock_guard{_mutex};
+    _queue.emplace_back(chunk_id);
+  }
+  _work_available.notify_one();
+}
+
+void CompressionService::wait_until_idle() {
+  auto lock = std::unique_lock{_mutex};
+  _idle.wait(lock, [&] { return _queue.empty() && _active_worker_count == 0; });
+
+  if (_exception) {
+    std::rethrow_exception(std::exchange(_exception, nullptr));
+  }
+}
+
+void CompressionService::_work() {
+  auto lock = std::unique_lock{_mutex};
+  while (true) {
+    _work_available.wait(lock, [&] { return _shutdown || !_queue.empty(); });
+    if (_shutdown) return;
+
+    const auto chunk_id = _queue.front();
+    _queue.pop_front();
+    ++_active_worker_count;
+
+    lock.unlock();
+    auto exception = std::exception_ptr{};
+    try {
+      _table.compress_chunk(chunk_id, _encoding_type);
+    } catch (...) {
+      // An exception escaping the thread would terminate the process, so it is passed on to wait_until_idle
+      exception = std::current_exception();
+    }
+    lock.lock();
+
+    if (exception && !_exception) _exception = exception;
+    --_active_worker_count;
+    if (_queue.empty() && _active_worker_count == 0) _idle.notify_all();
+  }
+}
+
+}  // namespace opossum
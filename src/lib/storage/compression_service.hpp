@@ -0,0 +1,54 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "encoding_type.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+// The CompressionService compresses chunks of a table on a number of worker threads, so that the thread inserting
+// into the table does not have to. Table enqueues each chunk as soon as it is full and thus immutable, see
+// Table::enable_auto_compression. The chunks are compressed using Table::compress_chunk.
+class CompressionService : private Noncopyable {
+ public:
+  CompressionService(Table& table, size_t worker_count, EncodingType encoding_type);
+
+  // Discards all chunks that were not picked up yet and waits for the workers to finish their current chunk
+  ~CompressionService();
+
+  // adds a chunk to the queue of chunks to compress
+  void enqueue(ChunkID chunk_id);
+
+  // Blocks until all enqueued chunks are compressed. If compressing a chunk failed, the first exception that occurred
+  // is rethrown here.
+  void wait_until_idle();
+
+ protected:
+  void _work();
+
+  Table& _table;
+  const EncodingType _encoding_type;
+  std::vector<std::thread> _workers;
+
+  // The following members are protected by _mutex
+  std::mutex _mutex;
+  std::deque<ChunkID> _queue;
+  size_t _active_worker_count{0};
+  bool _shutdown{false};
+  std::exception_ptr _exception;
+
+  // Signalled when a chunk is enqueued or the service shuts down
+  std::condition_variable _work_available;
+  // Signalled when a worker finished a chunk and no other chunk is queued
+  std::condition_variable _idle;
+};
+
+}  // namespace opossum
@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <limits>
-#include <map>
 #include <memory>
+#include <memory_resource>  // NOLINT(build/include_order)
+#include <numeric>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -13,9 +15,15 @@
 #include "all_type_variant.hpp"
 #include "base_attribute_vector.hpp"
 #include "base_segment.hpp"
+#include "bit_packed_attribute_vector.hpp"
+#include "bloom_filter.hpp"
 #include "fitted_attribute_vector.hpp"
+#include "front_coded_dictionary.hpp"
+#include "string_heap.hpp"
 #include "type_cast.hpp"
 #include "types.hpp"
+#include "utils/performance_warning.hpp"
+#include "value_segment.hpp"
 
 namespace opossum {
 
@@ -23,51 +31,56 @@ namespace opossum {
 // types (uint8_t, uint16_t) since after a down-cast INVALID_VALUE_ID will look like their numeric_limit::max()
 constexpr ValueID INVALID_VALUE_ID{std::numeric_limits<ValueID::base_type>::max()};
 
+// Formats the dictionary of a DictionarySegment can be stored in. FrontCoded only applies to strings, see
+// FrontCodedDictionary. Segments of other types always use a plain dictionary.
+enum class DictionaryFormat { Plain, FrontCoded };
+
 // Dictionary is a specific segment type that stores all its values in a vector
 template <typename T>
 class DictionarySegment : public BaseSegment {
  public:
   /**
    * Creates a Dictionary segment from a given value segment.
+   * The plain dictionary and the attribute vector are allocated from the given memory resource, which must outlive the
+   * segment. The membership filter and a front coded dictionary are small and always use the default resource.
    */
-  explicit DictionarySegment(const std::shared_ptr<BaseSegment>& base_segment) {
-    const auto size = base_segment->size();
-
-    // Create map as temporary dictionary
-    std::map<T, uint32_t> temp_dictionary{};
-    for (ValueID value_id{0}; value_id < size; ++value_id) {
-      auto value = type_cast<T>((*base_segment)[value_id]);
-      temp_dictionary[value] = 0;
-    }
-    const auto unique_values = temp_dictionary.size();
-    DebugAssert(unique_values < std::numeric_limits<uint32_t>::max(), "Segments cannot be larger than 2^32 items");
-
-    // Create dictionary
-    _dictionary = std::make_shared<std::vector<T>>(unique_values);
-    uint64_t counter = 0;
-    for (auto& [key, value] : temp_dictionary) {
-      value = counter;
-      (*_dictionary)[counter] = key;
-      counter++;
+  explicit DictionarySegment(const std::shared_ptr<BaseSegment>& base_segment,
+                             const DictionaryFormat format = DictionaryFormat::Plain,
+                             std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource()) {
+    if (const auto value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment); value_segment != nullptr) {
+      _build(value_segment->values(), memory_resource);
+    } else {
+      _build(_materialize(*base_segment), memory_resource);
     }
 
-    // Create attribute vector
-    if (unique_values < std::numeric_limits<uint8_t>::max()) {
-      _attribute_vector = std::make_shared<FittedAttributeVector<uint8_t>>(size);
-    } else if (unique_values < std::numeric_limits<uint16_t>::max()) {
-      _attribute_vector = std::make_shared<FittedAttributeVector<uint16_t>>(size);
-    } else {
-      _attribute_vector = std::make_shared<FittedAttributeVector<uint32_t>>(size);
+    if (unique_values_count() >= MEMBERSHIP_FILTER_MIN_UNIQUE_VALUES) {
+      auto membership_filter = std::make_shared<BloomFilter>(unique_values_count());
+      for (const auto& value : *_dictionary) membership_filter->insert(value);
+      _membership_filter = std::move(membership_filter);
     }
 
-    // Fill attribute vector
-    for (size_t position{0}; position < size; ++position) {
-      auto value = type_cast<T>((*base_segment)[position]);
-      auto value_id = ValueID{temp_dictionary[value]};
-      _attribute_vector->set(position, value_id);
+    if constexpr (std::is_same_v<T, std::string>) {
+      if (format == DictionaryFormat::FrontCoded) {
+        _front_coded_dictionary = std::make_shared<FrontCodedDictionary>(*_dictionary);
+        _dictionary = nullptr;
+      }
     }
   }
 
+  // Creates a DictionarySegment from its parts, e.g., when reading it from a file. Exactly one of the dictionaries has
+  // to be set. The membership filter is optional.
+  DictionarySegment(std::shared_ptr<ValueVector<T>> dictionary,
+                    std::shared_ptr<FrontCodedDictionary> front_coded_dictionary,
+                    std::shared_ptr<BaseAttributeVector> attribute_vector,
+                    std::shared_ptr<const BloomFilter> membership_filter)
+      : _dictionary{std::move(dictionary)},
+        _front_coded_dictionary{std::move(front_coded_dictionary)},
+        _membership_filter{std::move(membership_filter)},
+        _attribute_vector{std::move(attribute_vector)} {
+    Assert(!_dictionary != !_front_coded_dictionary, "DictionarySegment needs exactly one dictionary");
+    Assert(_attribute_vector, "DictionarySegment needs an attribute vector");
+  }
+
   // SEMINAR INFORMATION: Since most of these methods depend on the template parameter, you will have to implement
   // the DictionarySegment in this file. Replace the method signatures with actual implementations.
 
@@ -75,28 +88,51 @@ class DictionarySegment : public BaseSegment {
   const AllTypeVariant operator[](const size_t i) const override { return get(i); }
 
   // return the value at a certain position.
-  const T get(const size_t i) const { return (*_dictionary)[_attribute_vector->get(i)]; }
+  const T get(const size_t i) const { return value_by_value_id(_attribute_vector->get(i)); }
+
+  // return the value at a certain position without copying it. For strings, this is a std::string_view into the
+  // dictionary. Only available for plain dictionaries.
+  typename ValueVector<T>::const_reference get_view(const size_t i) const {
+    DebugAssert(_dictionary, "get_view() requires a plain dictionary");
+    return (*_dictionary)[_attribute_vector->get(i)];
+  }
 
   // dictionary segments are immutable
   void append(const AllTypeVariant&) override {
     throw std::runtime_error{"Cannot call append on immutable dictionary segment"};
   }
 
-  // returns an underlying dictionary
-  std::shared_ptr<const std::vector<T>> dictionary() const { return _dictionary; }
+  // returns an underlying dictionary, which is a StringHeap for strings. nullptr if the dictionary is front coded.
+  std::shared_ptr<const ValueVector<T>> dictionary() const { return _dictionary; }
+
+  // returns the underlying dictionary if it is front coded, nullptr otherwise
+  std::shared_ptr<const FrontCodedDictionary> front_coded_dictionary() const { return _front_coded_dictionary; }
 
   // returns an underlying data structure
   std::shared_ptr<const BaseAttributeVector> attribute_vector() const { return _attribute_vector; }
 
+  // Returns a filter containing all values of the dictionary, or nullptr if the dictionary is too small for a filter to
+  // be faster than searching it. TableScan uses it to rule out equality predicates without searching the dictionary.
+  std::shared_ptr<const BloomFilter> membership_filter() const { return _membership_filter; }
+
+  // dictionaries with fewer unique values fit into a few cache lines and are searched quickly, see membership_filter()
+  static constexpr size_t MEMBERSHIP_FILTER_MIN_UNIQUE_VALUES = 256;
+
   // return the value represented by a given ValueID
-  const T& value_by_value_id(ValueID value_id) const { return (*_dictionary)[value_id]; }
+  const T value_by_value_id(ValueID value_id) const {
+    if constexpr (std::is_same_v<T, std::string>) {
+      if (_front_coded_dictionary) return _front_coded_dictionary->get(value_id);
+    }
+    return T{(*_dictionary)[value_id]};
+  }
 
   // returns the first value ID that refers to a value >= the search value
   // returns INVALID_VALUE_ID if all values are smaller than the search value
-  ValueID lower_bound(T value) const {
-    const auto it = std::lower_bound(_dictionary->begin(), _dictionary->end(), value);
-    const auto position = ValueID{static_cast<uint32_t>(it - _dictionary->begin())};
-    return it == _dictionary->end() ? INVALID_VALUE_ID : position;
+  ValueID lower_bound(const T& value) const {
+    if constexpr (std::is_same_v<T, std::string>) {
+      if (_front_coded_dictionary) return _to_value_id(_front_coded_dictionary->lower_bound(value));
+    }
+    return _to_value_id(std::lower_bound(_dictionary->begin(), _dictionary->end(), value) - _dictionary->begin());
   }
 
   // same as lower_bound(T), but accepts an AllTypeVariant
@@ -104,23 +140,108 @@ class DictionarySegment : public BaseSegment {
 
   // returns the first value ID that refers to a value > the search value
   // returns INVALID_VALUE_ID if all values are smaller than or equal to the search value
-  ValueID upper_bound(T value) const {
-    const auto it = std::upper_bound(_dictionary->begin(), _dictionary->end(), value);
-    const auto position = ValueID{static_cast<uint32_t>(it - _dictionary->begin())};
-    return it == _dictionary->end() ? INVALID_VALUE_ID : position;
+  ValueID upper_bound(const T& value) const {
+    if constexpr (std::is_same_v<T, std::string>) {
+      if (_front_coded_dictionary) return _to_value_id(_front_coded_dictionary->upper_bound(value));
+    }
+    return _to_value_id(std::upper_bound(_dictionary->begin(), _dictionary->end(), value) - _dictionary->begin());
   }
 
   // same as upper_bound(T), but accepts an AllTypeVariant
   ValueID upper_bound(const AllTypeVariant& value) const { return upper_bound(type_cast<T>(value)); }
 
   // return the number of unique_values (dictionary entries)
-  size_t unique_values_count() const { return _dictionary->size(); }
+  size_t unique_values_count() const {
+    return _front_coded_dictionary ? _front_coded_dictionary->size() : _dictionary->size();
+  }
 
   // return the number of entries
   size_t size() const override { return _attribute_vector->size(); }
 
+  size_t estimate_memory_usage() const override {
+    auto bytes = sizeof(*this) + _attribute_vector->estimate_memory_usage();
+    if (_membership_filter) bytes += sizeof(BloomFilter) + _membership_filter->byte_count();
+    if constexpr (std::is_same_v<T, std::string>) {
+      if (_front_coded_dictionary) return bytes + _front_coded_dictionary->estimate_memory_usage();
+      return bytes + _dictionary->estimate_memory_usage();
+    } else {
+      return bytes + _dictionary->capacity() * sizeof(T);
+    }
+  }
+
  protected:
-  std::shared_ptr<std::vector<T>> _dictionary;
+  // Other segment types are materialized first, using a single virtual call per row
+  static ValueVector<T> _materialize(const BaseSegment& base_segment) {
+    PerformanceWarning("Dictionary encoding a segment that is not a ValueSegment");
+    const auto size = base_segment.size();
+    ValueVector<T> values;
+    values.reserve(size);
+    for (size_t position{0}; position < size; ++position) {
+      values.emplace_back(type_cast<T>(base_segment[position]));
+    }
+    return values;
+  }
+
+  // Converts a position in the dictionary into a value id, using INVALID_VALUE_ID for positions past the end
+  ValueID _to_value_id(const size_t position) const {
+    return position == unique_values_count() ? INVALID_VALUE_ID : ValueID{static_cast<uint32_t>(position)};
+  }
+
+  // Sorts the positions of all values by value. A single pass over the sorted positions then builds the dictionary and
+  // assigns the value ids. Apart from the positions, this does not allocate anything besides the dictionary and the
+  // attribute vector, and no value is copied more than once.
+  void _build(const ValueVector<T>& values, std::pmr::memory_resource* memory_resource) {
+    const auto size = values.size();
+    DebugAssert(size < std::numeric_limits<uint32_t>::max(), "Segments cannot be larger than 2^32 items");
+
+    std::vector<ChunkOffset> positions(size);
+    std::iota(positions.begin(), positions.end(), ChunkOffset{0});
+    std::sort(positions.begin(), positions.end(),
+              [&](const ChunkOffset lhs, const ChunkOffset rhs) { return values[lhs] < values[rhs]; });
+
+    // The number of unique values determines the width of the attribute vector, so it is counted beforehand
+    size_t unique_values = size > 0 ? 1 : 0;
+    for (size_t index{1}; index < size; ++index) {
+      if (values[positions[index - 1]] < values[positions[index]]) ++unique_values;
+    }
+
+    // Create attribute vector. A FittedAttributeVector is used if its width matches the number of bits needed for the
+    // value ids exactly, because it can be scanned faster. Otherwise, a BitPackedAttributeVector saves memory.
+    const auto max_value_id = static_cast<uint32_t>(std::max(unique_values, size_t{1}) - 1);
+    const auto bit_width = BitPackedAttributeVector::required_bit_width(max_value_id);
+    if (unique_values < std::numeric_limits<uint8_t>::max()) {
+      _attribute_vector = _create_attribute_vector<uint8_t>(size, bit_width, memory_resource);
+    } else if (unique_values < std::numeric_limits<uint16_t>::max()) {
+      _attribute_vector = _create_attribute_vector<uint16_t>(size, bit_width, memory_resource);
+    } else {
+      _attribute_vector = _create_attribute_vector<uint32_t>(size, bit_width, memory_resource);
+    }
+
+    // Create dictionary and fill attribute vector
+    _dictionary = std::make_shared<ValueVector<T>>(memory_resource);
+    _dictionary->reserve(unique_values);
+    for (const auto position : positions) {
+      const auto& value = values[position];
+      if (_dictionary->empty() || _dictionary->back() < value) {
+        _dictionary->emplace_back(value);
+      }
+      _attribute_vector->set(position, ValueID{static_cast<uint32_t>(_dictionary->size() - 1)});
+    }
+  }
+
+  // Creates a FittedAttributeVector<FittedType>, unless a BitPackedAttributeVector with the given bit width is smaller
+  template <typename FittedType>
+  static std::shared_ptr<BaseAttributeVector> _create_attribute_vector(const size_t size, const uint8_t bit_width,
+                                                                       std::pmr::memory_resource* memory_resource) {
+    if (bit_width < sizeof(FittedType) * 8) {
+      return std::make_shared<BitPackedAttributeVector>(size, bit_width, memory_resource);
+    }
+    return std::make_shared<FittedAttributeVector<FittedType>>(size, memory_resource);
+  }
+
+  std::shared_ptr<ValueVector<T>> _dictionary;
+  std::shared_ptr<FrontCodedDictionary> _front_coded_dictionary;
+  std::shared_ptr<const BloomFilter> _membership_filter;
   std::shared_ptr<BaseAttributeVector> _attribute_vector;
 };
 
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <vector>
+
+namespace opossum {
+
+// Encodings that immutable chunks can be compressed with, see Table::compress_chunk. FrontCodedDictionary only differs
+// from Dictionary for string segments.
+enum class EncodingType { Dictionary, FrontCodedDictionary, RunLength, FrameOfReference };
+
+// The encoding of each column of a chunk
+using ChunkEncodingSpec = std::vector<EncodingType>;
+
+}  // namespace opossum
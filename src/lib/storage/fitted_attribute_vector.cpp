@@ -1,6 +1,8 @@
 #include "fitted_attribute_vector.hpp"
 
 #include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "../utils/assert.hpp"
@@ -8,23 +10,30 @@
 namespace opossum {
 
 template <typename T>
-FittedAttributeVector<T>::FittedAttributeVector(size_t size) : _indices(size) {}
+FittedAttributeVector<T>::FittedAttributeVector(size_t size, std::pmr::memory_resource* memory_resource)
+    : _indices(size, memory_resource), _data{_indices.data()}, _size{size} {}
+
+template <typename T>
+FittedAttributeVector<T>::FittedAttributeVector(const T* data, const size_t size, std::shared_ptr<const void> owner)
+    : _data{data}, _size{size}, _owner{std::move(owner)} {}
 
 template <typename T>
 ValueID FittedAttributeVector<T>::get(const size_t i) const {
-  return ValueID{_indices[i]};
+  return ValueID{_data[i]};
 }
 
 template <typename T>
 void FittedAttributeVector<T>::set(const size_t i, const ValueID value_id) {
   DebugAssert(static_cast<uint32_t>(value_id) <= std::numeric_limits<T>::max(),
               "Value id out of range for value id type");
+  // Writing through the pointer to mapped memory would crash or change the file, so this is checked in release builds
+  Assert(!_is_referenced(), "Referenced attribute vectors are read-only");
   _indices[i] = value_id;
 }
 
 template <typename T>
 size_t FittedAttributeVector<T>::size() const {
-  return _indices.size();
+  return _size;
 }
 
 template <typename T>
@@ -32,11 +41,28 @@ AttributeVectorWidth FittedAttributeVector<T>::width() const {
   return sizeof(T);
 }
 
+template <typename T>
+size_t FittedAttributeVector<T>::estimate_memory_usage() const {
+  // Referenced value ids are counted as well, since they are part of the table's data even if they are mapped pages
+  return sizeof(*this) + _size * sizeof(T);
+}
+
 template <class T>
-const std::vector<T>& FittedAttributeVector<T>::indices() const {
+const T* FittedAttributeVector<T>::data() const {
+  return _data;
+}
+
+template <typename T>
+const std::pmr::vector<T>& FittedAttributeVector<T>::indices() const {
+  Assert(!_is_referenced(), "Referenced attribute vectors do not hold their value ids, use data() instead");
   return _indices;
 }
 
+template <typename T>
+bool FittedAttributeVector<T>::_is_referenced() const {
+  return _data != _indices.data();
+}
+
 template class FittedAttributeVector<uint8_t>;
 template class FittedAttributeVector<uint16_t>;
 template class FittedAttributeVector<uint32_t>;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <memory_resource>  // NOLINT(build/include_order)
 #include <vector>
 
 #include "base_attribute_vector.hpp"
@@ -9,7 +11,13 @@ namespace opossum {
 template <typename T>
 class FittedAttributeVector : public BaseAttributeVector {
  public:
-  explicit FittedAttributeVector(size_t size);
+  // creates an attribute vector of the given size, allocated from the given memory resource
+  explicit FittedAttributeVector(size_t size,
+                                 std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource());
+
+  // Creates a read-only attribute vector that references `size` value ids at `data` without copying them, e.g., in a
+  // memory-mapped file. The memory has to stay valid as long as `owner` is alive. Calling set() throws.
+  FittedAttributeVector(const T* data, size_t size, std::shared_ptr<const void> owner);
 
   ValueID get(const size_t i) const override;
 
@@ -19,10 +27,24 @@ class FittedAttributeVector : public BaseAttributeVector {
 
   AttributeVectorWidth width() const override;
 
-  const std::vector<T>& indices() const;
+  size_t estimate_memory_usage() const override;
+
+  // returns the value ids of all positions
+  const T* data() const;
+
+  // Returns the value ids of all positions if the attribute vector holds them. Use data() for attribute vectors that
+  // reference their value ids.
+  const std::pmr::vector<T>& indices() const;
 
  private:
-  std::vector<T> _indices;
+  // whether the value ids are referenced instead of held by the attribute vector, see the second constructor
+  bool _is_referenced() const;
+
+  // empty if the value ids are referenced
+  std::pmr::vector<T> _indices;
+  const T* _data;
+  size_t _size;
+  std::shared_ptr<const void> _owner;
 };
 
 }  // namespace opossum
@@ -0,0 +1,111 @@
+#include "frame_of_reference_segment.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "utils/performance_warning.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+template <typename T>
+FrameOfReferenceSegment<T>::FrameOfReferenceSegment(const std::shared_ptr<BaseSegment>& base_segment) {
+  if constexpr (std::is_integral_v<T>) {
+    const auto encode = [&](const auto& values) {
+      const auto size = values.size();
+      auto maximum = T{};
+      if (size > 0) {
+        const auto minmax = std::minmax_element(values.begin(), values.end());
+        _minimum = *minmax.first;
+        maximum = *minmax.second;
+      }
+
+      // Differences are computed in unsigned 64 bit arithmetic, which cannot overflow for minimum <= value
+      const auto range = static_cast<uint64_t>(maximum) - static_cast<uint64_t>(_minimum);
+      Assert(range <= std::numeric_limits<uint32_t>::max(),
+             "FrameOfReference encoding requires the values of a segment to span a range of less than 2^32");
+
+      const auto bit_width = BitPackedAttributeVector::required_bit_width(static_cast<uint32_t>(range));
+      _offsets = std::make_shared<BitPackedAttributeVector>(size, bit_width);
+      for (size_t position{0}; position < size; ++position) {
+        const auto offset = static_cast<uint64_t>(values[position]) - static_cast<uint64_t>(_minimum);
+        _offsets->set(position, ValueID{static_cast<uint32_t>(offset)});
+      }
+    };
+
+    if (const auto value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment);
+        value_segment != nullptr) {
+      encode(value_segment->values());
+    } else {
+      PerformanceWarning("Frame of reference encoding a segment that is not a ValueSegment");
+      std::vector<T> values;
+      values.reserve(base_segment->size());
+      for (size_t position{0}; position < base_segment->size(); ++position) {
+        values.emplace_back(type_cast<T>((*base_segment)[position]));
+      }
+      encode(values);
+    }
+  } else {
+    Fail("FrameOfReference encoding is only supported for integral types");
+  }
+}
+
+template <typename T>
+FrameOfReferenceSegment<T>::FrameOfReferenceSegment(T minimum, std::shared_ptr<BitPackedAttributeVector> offsets)
+    : _minimum{std::move(minimum)}, _offsets{std::move(offsets)} {
+  Assert(std::is_integral_v<T>, "FrameOfReference encoding is only supported for integral types");
+}
+
+template <typename T>
+const AllTypeVariant FrameOfReferenceSegment<T>::operator[](const size_t i) const {
+  PerformanceWarning("operator[] used");
+
+  return get(i);
+}
+
+template <typename T>
+const T FrameOfReferenceSegment<T>::get(const size_t i) const {
+  if constexpr (std::is_integral_v<T>) {
+    return static_cast<T>(static_cast<uint64_t>(_minimum) + _offsets->get(i));
+  } else {
+    Fail("FrameOfReference encoding is only supported for integral types");
+    return T{};
+  }
+}
+
+template <typename T>
+void FrameOfReferenceSegment<T>::append(const AllTypeVariant&) {
+  throw std::runtime_error{"Cannot call append on immutable frame of reference segment"};
+}
+
+template <typename T>
+size_t FrameOfReferenceSegment<T>::size() const {
+  return _offsets->size();
+}
+
+template <typename T>
+size_t FrameOfReferenceSegment<T>::estimate_memory_usage() const {
+  return sizeof(*this) + _offsets->estimate_memory_usage();
+}
+
+template <typename T>
+T FrameOfReferenceSegment<T>::minimum() const {
+  return _minimum;
+}
+
+template <typename T>
+std::shared_ptr<const BitPackedAttributeVector> FrameOfReferenceSegment<T>::offsets() const {
+  return _offsets;
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(FrameOfReferenceSegment);
+
+}  // namespace opossum
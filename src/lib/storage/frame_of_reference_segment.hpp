@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "base_segment.hpp"
+#include "bit_packed_attribute_vector.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// FrameOfReferenceSegment is an immutable segment type for integer columns. It stores the minimum of all values (the
+// frame of reference) once and, for each row, the offset of its value from that minimum in a BitPackedAttributeVector.
+// Columns with small value ranges, e.g., timestamps or ids within a chunk, thus need only a few bits per row.
+//
+// Only integral types are supported, and the values of a segment must not span a range larger than 2^32 - 1.
+template <typename T>
+class FrameOfReferenceSegment : public BaseSegment {
+ public:
+  // Creates a FrameOfReferenceSegment from a given value segment
+  explicit FrameOfReferenceSegment(const std::shared_ptr<BaseSegment>& base_segment);
+
+  // Creates a FrameOfReferenceSegment from the minimum and the offsets of another one
+  FrameOfReferenceSegment(T minimum, std::shared_ptr<BitPackedAttributeVector> offsets);
+
+  // return the value at a certain position. If you want to write efficient operators, back off!
+  const AllTypeVariant operator[](const size_t i) const override;
+
+  // return the value at a certain position
+  const T get(const size_t i) const;
+
+  // frame of reference segments are immutable
+  void append(const AllTypeVariant&) override;
+
+  // return the number of entries
+  size_t size() const override;
+
+  size_t estimate_memory_usage() const override;
+
+  // returns the smallest value of the segment, which all offsets are relative to
+  T minimum() const;
+
+  // returns the offset of each value from the minimum
+  std::shared_ptr<const BitPackedAttributeVector> offsets() const;
+
+ protected:
+  T _minimum{};
+  std::shared_ptr<BitPackedAttributeVector> _offsets;
+};
+
+}  // namespace opossum
@@ -0,0 +1,147 @@
+#include "front_coded_dictionary.hpp"
+
+#include <algorithm>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Lengths are stored as LEB128 varints: seven bits per byte, with the highest bit set on all but the last byte.
+// Most prefix and suffix lengths are below 128 and thus take a single byte.
+void write_length(std::vector<char>& bytes, size_t length) {
+  while (length >= 0x80) {
+    bytes.emplace_back(static_cast<char>((length & 0x7F) | 0x80));
+    length >>= 7;
+  }
+  bytes.emplace_back(static_cast<char>(length));
+}
+
+size_t read_length(const char*& position) {
+  auto length = size_t{0};
+  auto shift = 0u;
+  while (true) {
+    const auto byte = static_cast<unsigned char>(*position++);
+    length |= static_cast<size_t>(byte & 0x7F) << shift;
+    if (byte < 0x80) return length;
+    shift += 7;
+  }
+}
+
+// Appends the next string of a block to `value`, which holds the previous string
+void decode_next(const char*& position, std::string& value) {
+  const auto prefix_length = read_length(position);
+  const auto suffix_length = read_length(position);
+  value.resize(prefix_length);
+  value.append(position, suffix_length);
+  position += suffix_length;
+}
+
+}  // namespace
+
+FrontCodedDictionary::FrontCodedDictionary(const StringHeap& sorted_values) : _size{sorted_values.size()} {
+  _block_offsets.reserve((_size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+  auto previous = std::string_view{};
+  for (size_t index{0}; index < _size; ++index) {
+    const auto value = sorted_values[index];
+    DebugAssert(index == 0 || previous < value, "Values of a FrontCodedDictionary have to be sorted and unique");
+
+    auto prefix_length = size_t{0};
+    if (index % BLOCK_SIZE == 0) {
+      _block_offsets.emplace_back(_bytes.size());
+    } else {
+      const auto max_prefix_length = std::min(previous.size(), value.size());
+      while (prefix_length < max_prefix_length && previous[prefix_length] == value[prefix_length]) ++prefix_length;
+    }
+
+    write_length(_bytes, prefix_length);
+    write_length(_bytes, value.size() - prefix_length);
+    _bytes.insert(_bytes.end(), value.begin() + prefix_length, value.end());
+    previous = value;
+  }
+
+  _bytes.shrink_to_fit();
+}
+
+FrontCodedDictionary::FrontCodedDictionary(std::vector<char> bytes, std::vector<size_t> block_offsets, size_t size)
+    : _bytes{std::move(bytes)}, _block_offsets{std::move(block_offsets)}, _size{size} {
+  Assert(_block_offsets.size() == (_size + BLOCK_SIZE - 1) / BLOCK_SIZE,
+         "Number of blocks does not match the size of the FrontCodedDictionary");
+}
+
+std::string FrontCodedDictionary::get(const size_t i) const {
+  DebugAssert(i < _size, "Position out of range");
+
+  const auto block = i / BLOCK_SIZE;
+  const auto* position = _bytes.data() + _block_offsets[block];
+  auto value = std::string{};
+  for (auto index = block * BLOCK_SIZE; index <= i; ++index) {
+    decode_next(position, value);
+  }
+  return value;
+}
+
+size_t FrontCodedDictionary::lower_bound(const std::string_view value) const {
+  return _partition_point([&](const std::string_view entry) { return entry < value; });
+}
+
+size_t FrontCodedDictionary::upper_bound(const std::string_view value) const {
+  return _partition_point([&](const std::string_view entry) { return entry <= value; });
+}
+
+size_t FrontCodedDictionary::size() const { return _size; }
+
+size_t FrontCodedDictionary::byte_count() const { return _bytes.size(); }
+
+const std::vector<char>& FrontCodedDictionary::bytes() const { return _bytes; }
+
+const std::vector<size_t>& FrontCodedDictionary::block_offsets() const { return _block_offsets; }
+
+size_t FrontCodedDictionary::estimate_memory_usage() const {
+  return _bytes.capacity() + _block_offsets.capacity() * sizeof(size_t);
+}
+
+template <typename Predicate>
+size_t FrontCodedDictionary::_partition_point(const Predicate& predicate) const {
+  // Find the number of blocks whose restart point satisfies the predicate. The result lies in the last of them.
+  auto first_block = size_t{0};
+  auto block_count = _block_offsets.size();
+  while (block_count > 0) {
+    const auto half = block_count / 2;
+    if (predicate(_block_head(first_block + half))) {
+      first_block += half + 1;
+      block_count -= half + 1;
+    } else {
+      block_count = half;
+    }
+  }
+  if (first_block == 0) return 0;
+
+  // Decode the block until the predicate no longer holds
+  const auto block = first_block - 1;
+  const auto block_end = std::min((block + 1) * BLOCK_SIZE, _size);
+  const auto* position = _bytes.data() + _block_offsets[block];
+  auto value = std::string{};
+  decode_next(position, value);
+  for (auto index = block * BLOCK_SIZE + 1; index < block_end; ++index) {
+    decode_next(position, value);
+    if (!predicate(value)) return index;
+  }
+  return block_end;
+}
+
+std::string_view FrontCodedDictionary::_block_head(const size_t block) const {
+  const auto* position = _bytes.data() + _block_offsets[block];
+  // The prefix length of a restart point is always zero
+  read_length(position);
+  const auto length = read_length(position);
+  return std::string_view{position, length};
+}
+
+}  // namespace opossum
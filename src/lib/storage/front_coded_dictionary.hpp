@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <vector>
+
+#include "string_heap.hpp"
+
+namespace opossum {
+
+// FrontCodedDictionary is an immutable, prefix-compressed representation of a sorted list of unique strings. The
+// strings are split into blocks of BLOCK_SIZE. The first string of each block (its restart point) is stored in full.
+// Every other string only stores the length of the prefix it shares with its predecessor, followed by the remaining
+// suffix. Lengths are encoded as variable-length integers.
+//
+// Sorted strings such as URLs or paths often share long prefixes, so this needs much less memory than a StringHeap.
+// In exchange, accessing a string requires decoding its block up to that string. Searches first binary search the
+// restart points, which can be compared without decoding, and then decode a single block.
+class FrontCodedDictionary {
+ public:
+  static constexpr size_t BLOCK_SIZE = 16;
+
+  // Creates a FrontCodedDictionary from strings that are sorted and unique
+  explicit FrontCodedDictionary(const StringHeap& sorted_values);
+
+  // Creates a FrontCodedDictionary from the buffers returned by bytes() and block_offsets() of another one
+  FrontCodedDictionary(std::vector<char> bytes, std::vector<size_t> block_offsets, size_t size);
+
+  // return the string at a certain position
+  std::string get(const size_t i) const;
+
+  // returns the position of the first string >= the search value, or size() if there is none
+  size_t lower_bound(std::string_view value) const;
+
+  // returns the position of the first string > the search value, or size() if there is none
+  size_t upper_bound(std::string_view value) const;
+
+  // return the number of strings
+  size_t size() const;
+
+  // return the number of bytes used for the encoded strings, excluding the restart offsets
+  size_t byte_count() const;
+
+  // return the encoded strings
+  const std::vector<char>& bytes() const;
+
+  // return the offset of each block in bytes()
+  const std::vector<size_t>& block_offsets() const;
+
+  // return the number of bytes allocated for the encoded strings and the restart offsets
+  size_t estimate_memory_usage() const;
+
+ protected:
+  // Returns the number of strings at the beginning of the dictionary for which `predicate` holds. As in
+  // std::partition_point, the predicate must be true for a prefix of the strings and false for the rest.
+  template <typename Predicate>
+  size_t _partition_point(const Predicate& predicate) const;
+
+  // return the restart point of a block, which is stored without a prefix
+  std::string_view _block_head(const size_t block) const;
+
+  std::vector<char> _bytes;
+  std::vector<size_t> _block_offsets;
+  size_t _size;
+};
+
+}  // namespace opossum
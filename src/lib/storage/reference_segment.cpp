@@ -7,23 +7,58 @@
 namespace opossum {
 
 ReferenceSegment::ReferenceSegment(const std::shared_ptr<const Table> referenced_table,
-                                   const ColumnID referenced_column_id, const std::shared_ptr<const PosList> pos)
-    : _referenced_table{referenced_table}, _referenced_column_id{referenced_column_id}, _pos_list{pos} {}
+                                   const ColumnID referenced_column_id, const std::shared_ptr<const PosList> pos,
+                                   const bool references_single_chunk)
+    : _referenced_table{referenced_table},
+      _referenced_column_id{referenced_column_id},
+      _pos_list{pos},
+      _references_single_chunk{references_single_chunk} {
+  DebugAssert(!_references_single_chunk || _positions_are_in_single_chunk(), "Positions span several chunks");
+}
+
+ReferenceSegment::ReferenceSegment(const std::shared_ptr<const Table> referenced_table,
+                                   const ColumnID referenced_column_id,
+                                   const std::shared_ptr<const RowIDBitmap> row_id_bitmap,
+                                   const bool references_single_chunk)
+    : _referenced_table{referenced_table},
+      _referenced_column_id{referenced_column_id},
+      _row_id_bitmap{row_id_bitmap},
+      _references_single_chunk{references_single_chunk} {
+  DebugAssert(!_references_single_chunk || _positions_are_in_single_chunk(), "Positions span several chunks");
+}
 
 const AllTypeVariant ReferenceSegment::operator[](const size_t i) const {
-  DebugAssert(i < _pos_list->size(), "Index to reference segment out of bounds");
-  const auto row_id = (*_pos_list)[i];
+  DebugAssert(i < size(), "Index to reference segment out of bounds");
+  const auto row_id = _pos_list ? (*_pos_list)[i] : (*_row_id_bitmap)[i];
   const auto& chunk = _referenced_table->get_chunk(row_id.chunk_id);
   const auto segment = chunk.get_segment(_referenced_column_id);
   return (*segment)[row_id.chunk_offset];
 }
 
-size_t ReferenceSegment::size() const { return _pos_list->size(); }
+size_t ReferenceSegment::size() const { return _pos_list ? _pos_list->size() : _row_id_bitmap->size(); }
+
+size_t ReferenceSegment::estimate_memory_usage() const { return sizeof(*this) + estimate_positions_memory_usage(); }
+
+size_t ReferenceSegment::estimate_positions_memory_usage() const {
+  return _pos_list ? _pos_list->capacity() * sizeof(RowID) + sizeof(PosList) : _row_id_bitmap->byte_count();
+}
 
 const std::shared_ptr<const PosList> ReferenceSegment::pos_list() const { return _pos_list; }
 
+const std::shared_ptr<const RowIDBitmap> ReferenceSegment::row_id_bitmap() const { return _row_id_bitmap; }
+
 const std::shared_ptr<const Table> ReferenceSegment::referenced_table() const { return _referenced_table; }
 
 ColumnID ReferenceSegment::referenced_column_id() const { return _referenced_column_id; }
 
+bool ReferenceSegment::references_single_chunk() const { return _references_single_chunk; }
+
+bool ReferenceSegment::_positions_are_in_single_chunk() const {
+  if (size() == 0) return true;
+  const auto chunk_id = (_pos_list ? (*_pos_list)[0] : (*_row_id_bitmap)[0]).chunk_id;
+  auto single_chunk = true;
+  for_each_row_id([&](const RowID& row_id) { single_chunk &= row_id.chunk_id == chunk_id; });
+  return single_chunk;
+}
+
 }  // namespace opossum
@@ -9,6 +9,7 @@
 
 #include "base_segment.hpp"
 #include "dictionary_segment.hpp"
+#include "row_id_bitmap.hpp"
 #include "table.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
@@ -16,13 +17,19 @@
 
 namespace opossum {
 
-// ReferenceSegment is a specific segment type that stores all its values as position list of a referenced segment
+// ReferenceSegment is a specific segment type that stores all its values as position list of a referenced segment.
+// The positions are either stored in a PosList or, if there are many of them, in a RowIDBitmap.
 class ReferenceSegment : public BaseSegment {
  public:
   // creates a reference segment
-  // the parameters specify the positions and the referenced segment
+  // the parameters specify the positions and the referenced segment. If the creator knows that all positions are in
+  // the same chunk of the referenced table, it sets references_single_chunk, so that consumers can resolve the
+  // referenced segment once instead of once per position.
   ReferenceSegment(const std::shared_ptr<const Table> referenced_table, const ColumnID referenced_column_id,
-                   const std::shared_ptr<const PosList> pos);
+                   const std::shared_ptr<const PosList> pos, const bool references_single_chunk = false);
+
+  ReferenceSegment(const std::shared_ptr<const Table> referenced_table, const ColumnID referenced_column_id,
+                   const std::shared_ptr<const RowIDBitmap> row_id_bitmap, const bool references_single_chunk = false);
 
   const AllTypeVariant operator[](const size_t i) const override;
 
@@ -30,15 +37,44 @@ class ReferenceSegment : public BaseSegment {
 
   size_t size() const override;
 
+  // Includes the positions, but not the referenced table. Note that all segments of a table created by TableScan share
+  // the same positions.
+  size_t estimate_memory_usage() const override;
+
+  // returns the number of bytes used by the positions alone, which may be shared with other segments
+  size_t estimate_positions_memory_usage() const;
+
+  // returns the referenced positions, or nullptr if they are stored in a RowIDBitmap
   const std::shared_ptr<const PosList> pos_list() const;
+
+  // returns the referenced positions, or nullptr if they are stored in a PosList
+  const std::shared_ptr<const RowIDBitmap> row_id_bitmap() const;
+
+  // calls functor(const RowID&) for all referenced positions, regardless of how they are stored
+  template <typename Functor>
+  void for_each_row_id(const Functor& functor) const {
+    if (_pos_list) {
+      for (const auto& row_id : *_pos_list) functor(row_id);
+    } else {
+      _row_id_bitmap->for_each(functor);
+    }
+  }
+
   const std::shared_ptr<const Table> referenced_table() const;
 
   ColumnID referenced_column_id() const;
 
+  // returns true if all positions are guaranteed to be in the same chunk of the referenced table
+  bool references_single_chunk() const;
+
  protected:
+  bool _positions_are_in_single_chunk() const;
+
   const std::shared_ptr<const Table> _referenced_table;
   const ColumnID _referenced_column_id;
   const std::shared_ptr<const PosList> _pos_list;
+  const std::shared_ptr<const RowIDBitmap> _row_id_bitmap;
+  const bool _references_single_chunk;
 };
 
 }  // namespace opossum
@@ -0,0 +1,114 @@
+#include "row_id_bitmap.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+constexpr size_t BITMAP_WORD_COUNT = (1u << 16) / 64;
+
+// number of 64-bit words per block of the rank directory of a bitmap container
+constexpr size_t BLOCK_WORD_COUNT = 8;
+
+}  // namespace
+
+void RowIDBitmap::push_back(const RowID& row_id) {
+  const auto key = static_cast<uint16_t>(row_id.chunk_offset >> 16);
+  const auto low = static_cast<uint16_t>(row_id.chunk_offset & 0xFFFF);
+
+  if (_containers.empty() || _containers.back().chunk_id != row_id.chunk_id || _containers.back().key != key) {
+    DebugAssert(_containers.empty() || std::tie(_containers.back().chunk_id, _containers.back().key) <
+                                           std::tie(row_id.chunk_id, key),
+                "RowIDs have to be added in ascending order");
+    _containers.emplace_back(Container{row_id.chunk_id, key, _size, 0, {}, {}, {}});
+  }
+
+  auto& container = _containers.back();
+  if (container.bitmap.empty()) {
+    DebugAssert(container.array.empty() || container.array.back() < low, "RowIDs have to be added in ascending order");
+    container.array.emplace_back(low);
+
+    if (container.array.size() > ARRAY_CONTAINER_MAX_SIZE) {
+      container.bitmap.resize(BITMAP_WORD_COUNT);
+      for (const auto array_low : container.array) {
+        container.bitmap[array_low / 64] |= uint64_t{1} << (array_low % 64);
+      }
+      container.array.clear();
+      container.array.shrink_to_fit();
+
+      auto rank = size_t{0};
+      for (size_t word_index{0}; word_index <= low / 64; ++word_index) {
+        if (word_index % BLOCK_WORD_COUNT == 0) container.block_ranks.emplace_back(static_cast<uint16_t>(rank));
+        rank += static_cast<size_t>(__builtin_popcountll(container.bitmap[word_index]));
+      }
+    }
+  } else {
+    // All previous positions are smaller, so they precede each block that is started here
+    while (container.block_ranks.size() <= low / 64 / BLOCK_WORD_COUNT) {
+      container.block_ranks.emplace_back(static_cast<uint16_t>(container.cardinality));
+    }
+    container.bitmap[low / 64] |= uint64_t{1} << (low % 64);
+  }
+
+  ++container.cardinality;
+  ++_size;
+}
+
+size_t RowIDBitmap::size() const { return _size; }
+
+bool RowIDBitmap::empty() const { return _size == 0; }
+
+RowID RowIDBitmap::operator[](const size_t i) const {
+  DebugAssert(i < _size, "Index out of range");
+  const auto container_it = std::prev(std::upper_bound(
+      _containers.begin(), _containers.end(), i,
+      [](const size_t index, const Container& container) { return index < container.first_index; }));
+  const auto& container = *container_it;
+  const auto base = static_cast<ChunkOffset>(container.key) << 16;
+  auto rank = i - container.first_index;
+
+  if (container.bitmap.empty()) {
+    return RowID{container.chunk_id, base | container.array[rank]};
+  }
+
+  // The last block whose preceding positions do not exceed the rank holds the position
+  const auto block_it = std::prev(std::upper_bound(container.block_ranks.begin(), container.block_ranks.end(), rank));
+  rank -= *block_it;
+  const auto first_word = static_cast<size_t>(block_it - container.block_ranks.begin()) * BLOCK_WORD_COUNT;
+  for (auto word_index = first_word; word_index < first_word + BLOCK_WORD_COUNT; ++word_index) {
+    auto word = container.bitmap[word_index];
+    const auto word_cardinality = static_cast<size_t>(__builtin_popcountll(word));
+    if (rank < word_cardinality) {
+      for (; rank > 0; --rank) word &= word - 1;
+      const auto bit = static_cast<ChunkOffset>(__builtin_ctzll(word));
+      return RowID{container.chunk_id, base + static_cast<ChunkOffset>(word_index * 64) + bit};
+    }
+    rank -= word_cardinality;
+  }
+  Fail("Block ranks do not match the bitmap");
+  return RowID{};
+}
+
+PosList RowIDBitmap::to_pos_list() const {
+  PosList pos_list;
+  pos_list.reserve(_size);
+  for_each([&](const RowID& row_id) { pos_list.emplace_back(row_id); });
+  return pos_list;
+}
+
+size_t RowIDBitmap::byte_count() const {
+  auto bytes = _containers.capacity() * sizeof(Container);
+  for (const auto& container : _containers) {
+    bytes += container.array.capacity() * sizeof(uint16_t) + container.bitmap.capacity() * sizeof(uint64_t) +
+             container.block_ranks.capacity() * sizeof(uint16_t);
+  }
+  return bytes;
+}
+
+}  // namespace opossum
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// RowIDBitmap is a compressed set of RowIDs and an alternative to a PosList for scans that select many rows. Following
+// Roaring bitmaps, the offsets of each chunk are split into containers of 2^16 consecutive offsets. Sparse containers
+// store the lower 16 bits of their offsets in a sorted array, dense containers use a bitmap of 2^16 bits (8 KB).
+// Where a PosList needs 8 bytes per position, an array container needs 2 bytes and a bitmap container 1 bit per offset
+// in its range. Bitmap containers keep the number of positions before each block of 512 bits, so that operator[] only
+// has to count the bits of a single block.
+//
+// RowIDs have to be added in ascending order, which is the order in which TableScan finds them in a table.
+class RowIDBitmap : private Noncopyable {
+ public:
+  // Containers with more positions are stored as bitmaps, which are smaller from this size on
+  static constexpr size_t ARRAY_CONTAINER_MAX_SIZE = 4096;
+
+  // adds a RowID, which has to be larger than all RowIDs added before
+  void push_back(const RowID& row_id);
+
+  // return the number of positions
+  size_t size() const;
+
+  bool empty() const;
+
+  // return the position with the given index. Use for_each() to iterate over all positions.
+  RowID operator[](size_t i) const;
+
+  // calls functor(const RowID&) for all positions in ascending order
+  template <typename Functor>
+  void for_each(const Functor& functor) const {
+    for (const auto& container : _containers) {
+      const auto base = static_cast<ChunkOffset>(container.key) << 16;
+      if (container.bitmap.empty()) {
+        for (const auto low : container.array) {
+          functor(RowID{container.chunk_id, base | low});
+        }
+      } else {
+        for (size_t word_index{0}; word_index < container.bitmap.size(); ++word_index) {
+          auto word = container.bitmap[word_index];
+          while (word != 0) {
+            const auto bit = static_cast<ChunkOffset>(__builtin_ctzll(word));
+            functor(RowID{container.chunk_id, base + static_cast<ChunkOffset>(word_index * 64) + bit});
+            word &= word - 1;
+          }
+        }
+      }
+    }
+  }
+
+  // return all positions as a PosList
+  PosList to_pos_list() const;
+
+  // return the number of bytes used by the containers
+  size_t byte_count() const;
+
+ protected:
+  struct Container {
+    ChunkID chunk_id;
+    // upper 16 bits of all offsets in the container
+    uint16_t key;
+    // number of positions in all previous containers
+    size_t first_index;
+    uint32_t cardinality;
+    // lower 16 bits of the offsets, used as long as the container is sparse
+    std::vector<uint16_t> array;
+    // one bit per offset, used once the container is dense
+    std::vector<uint64_t> bitmap;
+    // number of positions in the previous blocks of the bitmap, up to the block of the last position
+    std::vector<uint16_t> block_ranks;
+  };
+
+  std::vector<Container> _containers;
+  size_t _size{0};
+};
+
+}  // namespace opossum
@@ -0,0 +1,101 @@
+#include "run_length_segment.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "utils/performance_warning.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+template <typename T>
+RunLengthSegment<T>::RunLengthSegment(const std::shared_ptr<BaseSegment>& base_segment) {
+  const auto encode = [&](const auto& values) {
+    const auto size = values.size();
+    for (size_t position{0}; position < size; ++position) {
+      if (_values.empty() || !(values[position] == _values.back())) {
+        if (!_values.empty()) _end_positions.emplace_back(static_cast<ChunkOffset>(position));
+        _values.emplace_back(values[position]);
+      }
+    }
+    if (!_values.empty()) _end_positions.emplace_back(static_cast<ChunkOffset>(size));
+  };
+
+  if (const auto value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment); value_segment != nullptr) {
+    encode(value_segment->values());
+  } else {
+    PerformanceWarning("Run length encoding a segment that is not a ValueSegment");
+    std::vector<T> values;
+    values.reserve(base_segment->size());
+    for (size_t position{0}; position < base_segment->size(); ++position) {
+      values.emplace_back(type_cast<T>((*base_segment)[position]));
+    }
+    encode(values);
+  }
+
+  _values.shrink_to_fit();
+  _end_positions.shrink_to_fit();
+}
+
+template <typename T>
+RunLengthSegment<T>::RunLengthSegment(std::vector<T> values, std::vector<ChunkOffset> end_positions)
+    : _values{std::move(values)}, _end_positions{std::move(end_positions)} {
+  Assert(_values.size() == _end_positions.size(), "Each run needs a value and an end position");
+}
+
+template <typename T>
+const AllTypeVariant RunLengthSegment<T>::operator[](const size_t i) const {
+  PerformanceWarning("operator[] used");
+
+  return get(i);
+}
+
+template <typename T>
+const T RunLengthSegment<T>::get(const size_t i) const {
+  DebugAssert(i < size(), "Position out of range");
+  const auto run = std::upper_bound(_end_positions.cbegin(), _end_positions.cend(), i) - _end_positions.cbegin();
+  return _values[run];
+}
+
+template <typename T>
+void RunLengthSegment<T>::append(const AllTypeVariant&) {
+  throw std::runtime_error{"Cannot call append on immutable run length segment"};
+}
+
+template <typename T>
+size_t RunLengthSegment<T>::size() const {
+  return _end_positions.empty() ? 0 : _end_positions.back();
+}
+
+template <typename T>
+size_t RunLengthSegment<T>::estimate_memory_usage() const {
+  auto bytes = sizeof(*this) + _values.capacity() * sizeof(T) + _end_positions.capacity() * sizeof(ChunkOffset);
+  if constexpr (std::is_same_v<T, std::string>) {
+    // Short strings are stored within std::string itself, longer ones are allocated on the heap
+    for (const auto& value : _values) {
+      if (value.capacity() > std::string{}.capacity()) bytes += value.capacity() + 1;
+    }
+  }
+  return bytes;
+}
+
+template <typename T>
+const std::vector<T>& RunLengthSegment<T>::values() const {
+  return _values;
+}
+
+template <typename T>
+const std::vector<ChunkOffset>& RunLengthSegment<T>::end_positions() const {
+  return _end_positions;
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(RunLengthSegment);
+
+}  // namespace opossum
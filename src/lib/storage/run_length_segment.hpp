@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// RunLengthSegment is an immutable segment type that stores runs of equal consecutive values only once, together with
+// the position at which each run ends. It is well suited for sorted or clustered columns.
+template <typename T>
+class RunLengthSegment : public BaseSegment {
+ public:
+  // Creates a RunLengthSegment from a given value segment
+  explicit RunLengthSegment(const std::shared_ptr<BaseSegment>& base_segment);
+
+  // Creates a RunLengthSegment from the runs returned by values() and end_positions() of another one
+  RunLengthSegment(std::vector<T> values, std::vector<ChunkOffset> end_positions);
+
+  // return the value at a certain position. If you want to write efficient operators, back off!
+  const AllTypeVariant operator[](const size_t i) const override;
+
+  // return the value at a certain position. Finding the run requires a binary search.
+  const T get(const size_t i) const;
+
+  // run length segments are immutable
+  void append(const AllTypeVariant&) override;
+
+  // return the number of entries
+  size_t size() const override;
+
+  size_t estimate_memory_usage() const override;
+
+  // returns the value of each run
+  const std::vector<T>& values() const;
+
+  // returns the position one past the last position of each run. The first run starts at position 0, and every
+  // subsequent run starts at the end position of its predecessor.
+  const std::vector<ChunkOffset>& end_positions() const;
+
+ protected:
+  std::vector<T> _values;
+  std::vector<ChunkOffset> _end_positions;
+};
+
+}  // namespace opossum
@@ -0,0 +1,76 @@
+#include "segment_encoding_utils.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dictionary_segment.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "reference_segment.hpp"
+#include "resolve_type.hpp"
+#include "run_length_segment.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+#include "zone_map.hpp"
+
+namespace opossum {
+
+std::shared_ptr<BaseSegment> encode_segment(EncodingType encoding_type, const std::string& data_type,
+                                            const std::shared_ptr<BaseSegment>& segment) {
+  switch (encoding_type) {
+    case EncodingType::Dictionary:
+      return make_shared_by_data_type<BaseSegment, DictionarySegment>(data_type, segment);
+    case EncodingType::FrontCodedDictionary:
+      return make_shared_by_data_type<BaseSegment, DictionarySegment>(data_type, segment, DictionaryFormat::FrontCoded);
+    case EncodingType::RunLength:
+      return make_shared_by_data_type<BaseSegment, RunLengthSegment>(data_type, segment);
+    case EncodingType::FrameOfReference:
+      return make_shared_by_data_type<BaseSegment, FrameOfReferenceSegment>(data_type, segment);
+  }
+  Fail("Unknown encoding type");
+  return nullptr;
+}
+
+Chunk finish_chunk(Chunk chunk, const std::vector<std::string>& column_types,
+                   const std::optional<EncodingType> encoding_type) {
+  std::vector<std::shared_ptr<const BaseZoneMap>> zone_maps;
+  for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
+    zone_maps.emplace_back(
+        make_shared_by_data_type<BaseZoneMap, ZoneMap>(column_types[column_id], chunk.get_segment(column_id)));
+  }
+
+  if (encoding_type) {
+    Chunk encoded_chunk;
+    for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
+      encoded_chunk.add_segment(encode_segment(*encoding_type, column_types[column_id], chunk.get_segment(column_id)));
+    }
+    chunk = std::move(encoded_chunk);
+  }
+  chunk.set_zone_maps(zone_maps);
+  return chunk;
+}
+
+std::string segment_encoding_name(const std::string& data_type, const std::shared_ptr<const BaseSegment>& segment) {
+  if (std::dynamic_pointer_cast<const ReferenceSegment>(segment)) return "Reference";
+
+  auto name = std::string{};
+  resolve_data_type(data_type, [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+    if (std::dynamic_pointer_cast<const ValueSegment<ColumnDataType>>(segment)) {
+      name = "Unencoded";
+    } else if (const auto dictionary_segment =
+                   std::dynamic_pointer_cast<const DictionarySegment<ColumnDataType>>(segment)) {
+      name = dictionary_segment->front_coded_dictionary() ? "FrontCodedDictionary" : "Dictionary";
+    } else if (std::dynamic_pointer_cast<const RunLengthSegment<ColumnDataType>>(segment)) {
+      name = "RunLength";
+    } else if (std::dynamic_pointer_cast<const FrameOfReferenceSegment<ColumnDataType>>(segment)) {
+      name = "FrameOfReference";
+    }
+  });
+  Assert(!name.empty(), "Unknown segment type");
+  return name;
+}
+
+}  // namespace opossum
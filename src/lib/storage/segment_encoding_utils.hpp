@@ -0,0 +1,28 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "chunk.hpp"
+#include "encoding_type.hpp"
+
+namespace opossum {
+
+class BaseSegment;
+
+// Encodes a segment of the given data type with the given encoding
+std::shared_ptr<BaseSegment> encode_segment(EncodingType encoding_type, const std::string& data_type,
+                                            const std::shared_ptr<BaseSegment>& segment);
+
+// Builds the zone maps of a full chunk of ValueSegments and encodes its segments, if an encoding is given. This is
+// what Table::append does once a chunk is full, for loaders that fill whole chunks themselves, see load_table.
+Chunk finish_chunk(Chunk chunk, const std::vector<std::string>& column_types,
+                   std::optional<EncodingType> encoding_type);
+
+// Returns the name of the encoding of a segment of the given data type, e.g., "Dictionary". ValueSegments are
+// "Unencoded", ReferenceSegments are "Reference".
+std::string segment_encoding_name(const std::string& data_type, const std::shared_ptr<const BaseSegment>& segment);
+
+}  // namespace opossum
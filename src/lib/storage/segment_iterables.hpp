@@ -0,0 +1,401 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>  // NOLINT(build/include_order)
+#include <vector>
+
+#include "base_attribute_vector.hpp"
+#include "base_segment.hpp"
+#include "bit_packed_attribute_vector.hpp"
+#include "dictionary_segment.hpp"
+#include "fitted_attribute_vector.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "reference_segment.hpp"
+#include "resolve_type.hpp"
+#include "run_length_segment.hpp"
+#include "table.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+/**
+ * Segment iterables give operators typed access to the values of a segment without a virtual call per value. The
+ * concrete type of a segment is resolved once using resolve_segment_type, and an iterable is created for it using
+ * create_iterable. Every iterable offers
+ *
+ *   - for_each(functor), which calls functor(value, position) for all values of the segment in order, and
+ *   - for_each_at(offsets, count, functor), which calls functor(value, index) for the values at offsets[index].
+ *
+ * The functor is a generic lambda, so that it is instantiated for each type of segment and its loop is inlined. Values
+ * are passed without copying them where possible, e.g., strings of a ValueSegment as std::string_view. Positions are
+ * the ChunkOffsets of the values in the iterated segment.
+ *
+ * Example:
+ *
+ *   segment_for_each<int32_t>(*segment, [&](const auto& value, const auto position) { sum += value; });
+ */
+
+// Calls functor(attribute_vector) with the attribute vector cast to its concrete type
+template <typename Functor>
+void resolve_attribute_vector_type(const BaseAttributeVector& attribute_vector, const Functor& functor) {
+  if (const auto* uint8_vector = dynamic_cast<const FittedAttributeVector<uint8_t>*>(&attribute_vector)) {
+    functor(*uint8_vector);
+  } else if (const auto* uint16_vector = dynamic_cast<const FittedAttributeVector<uint16_t>*>(&attribute_vector)) {
+    functor(*uint16_vector);
+  } else if (const auto* uint32_vector = dynamic_cast<const FittedAttributeVector<uint32_t>*>(&attribute_vector)) {
+    functor(*uint32_vector);
+  } else if (const auto* bit_packed_vector = dynamic_cast<const BitPackedAttributeVector*>(&attribute_vector)) {
+    functor(*bit_packed_vector);
+  } else {
+    Fail("Unknown attribute vector type");
+  }
+}
+
+// Calls functor(segment) with the segment cast to its concrete type, i.e., ValueSegment<T>, DictionarySegment<T>,
+// RunLengthSegment<T>, FrameOfReferenceSegment<T>, or ReferenceSegment
+template <typename T, typename Functor>
+void resolve_segment_type(const BaseSegment& segment, const Functor& functor) {
+  if (const auto* value_segment = dynamic_cast<const ValueSegment<T>*>(&segment)) {
+    functor(*value_segment);
+  } else if (const auto* dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment)) {
+    functor(*dictionary_segment);
+  } else if (const auto* run_length_segment = dynamic_cast<const RunLengthSegment<T>*>(&segment)) {
+    functor(*run_length_segment);
+  } else if (const auto* frame_of_reference_segment = dynamic_cast<const FrameOfReferenceSegment<T>*>(&segment)) {
+    functor(*frame_of_reference_segment);
+  } else if (const auto* reference_segment = dynamic_cast<const ReferenceSegment*>(&segment)) {
+    functor(*reference_segment);
+  } else {
+    Fail("Unknown segment type");
+  }
+}
+
+// Calls functor(value_id, offset) for all value ids of an attribute vector. Bit-packed value ids are decoded in blocks.
+template <typename AttributeVector, typename Functor>
+void attribute_vector_for_each(const AttributeVector& attribute_vector, const Functor& functor) {
+  const auto size = attribute_vector.size();
+  if constexpr (std::is_same_v<AttributeVector, BitPackedAttributeVector>) {
+    constexpr auto block_size = size_t{1024};
+    std::array<uint32_t, block_size> value_ids;
+    for (size_t begin = 0; begin < size; begin += block_size) {
+      const auto count = std::min(block_size, size - begin);
+      attribute_vector.decode(begin, count, value_ids.data());
+      for (size_t index = 0; index < count; ++index) {
+        functor(value_ids[index], static_cast<ChunkOffset>(begin + index));
+      }
+    }
+  } else {
+    const auto* const value_ids = attribute_vector.data();
+    for (ChunkOffset offset{0}; offset < size; ++offset) {
+      functor(value_ids[offset], offset);
+    }
+  }
+}
+
+// returns the value id at the given offset of an attribute vector
+template <typename AttributeVector>
+uint32_t attribute_vector_get(const AttributeVector& attribute_vector, const ChunkOffset offset) {
+  if constexpr (std::is_same_v<AttributeVector, BitPackedAttributeVector>) {
+    return attribute_vector.get(offset);
+  } else {
+    return attribute_vector.data()[offset];
+  }
+}
+
+template <typename T>
+class ValueSegmentIterable {
+ public:
+  explicit ValueSegmentIterable(const ValueSegment<T>& segment) : _values{&segment.values()} {}
+
+  template <typename Functor>
+  void for_each(const Functor& functor) const {
+    const auto& values = *_values;
+    const auto size = values.size();
+    for (ChunkOffset offset{0}; offset < size; ++offset) {
+      functor(values[offset], offset);
+    }
+  }
+
+  template <typename Functor>
+  void for_each_at(const ChunkOffset* offsets, const size_t count, const Functor& functor) const {
+    const auto& values = *_values;
+    for (size_t index = 0; index < count; ++index) {
+      functor(values[offsets[index]], index);
+    }
+  }
+
+ protected:
+  const ValueVector<T>* _values;
+};
+
+template <typename T>
+class DictionarySegmentIterable {
+ public:
+  explicit DictionarySegmentIterable(const DictionarySegment<T>& segment) : _segment{&segment} {}
+
+  template <typename Functor>
+  void for_each(const Functor& functor) const {
+    _resolve([&](const auto& attribute_vector, const auto& get_value) {
+      attribute_vector_for_each(attribute_vector, [&](const uint32_t value_id, const ChunkOffset offset) {
+        functor(get_value(value_id), offset);
+      });
+    });
+  }
+
+  template <typename Functor>
+  void for_each_at(const ChunkOffset* offsets, const size_t count, const Functor& functor) const {
+    _resolve([&](const auto& attribute_vector, const auto& get_value) {
+      for (size_t index = 0; index < count; ++index) {
+        functor(get_value(attribute_vector_get(attribute_vector, offsets[index])), index);
+      }
+    });
+  }
+
+ protected:
+  // Resolves the attribute vector and the dictionary once and calls functor(attribute_vector, get_value), where
+  // get_value(value_id) returns the value of a value id
+  template <typename Functor>
+  void _resolve(const Functor& functor) const {
+    resolve_attribute_vector_type(*_segment->attribute_vector(), [&](const auto& attribute_vector) {
+      if constexpr (std::is_same_v<T, std::string>) {
+        if (const auto front_coded_dictionary = _segment->front_coded_dictionary()) {
+          functor(attribute_vector, [&](const uint32_t value_id) { return front_coded_dictionary->get(value_id); });
+          return;
+        }
+      }
+      const auto& dictionary = *_segment->dictionary();
+      functor(attribute_vector, [&](const uint32_t value_id) -> typename ValueVector<T>::const_reference {
+        return dictionary[value_id];
+      });
+    });
+  }
+
+  const DictionarySegment<T>* _segment;
+};
+
+template <typename T>
+class RunLengthSegmentIterable {
+ public:
+  explicit RunLengthSegmentIterable(const RunLengthSegment<T>& segment) : _segment{&segment} {}
+
+  template <typename Functor>
+  void for_each(const Functor& functor) const {
+    const auto& values = _segment->values();
+    const auto& end_positions = _segment->end_positions();
+    ChunkOffset offset{0};
+    for (size_t run = 0; run < values.size(); ++run) {
+      for (; offset < end_positions[run]; ++offset) {
+        functor(values[run], offset);
+      }
+    }
+  }
+
+  template <typename Functor>
+  void for_each_at(const ChunkOffset* offsets, const size_t count, const Functor& functor) const {
+    const auto& values = _segment->values();
+    const auto& end_positions = _segment->end_positions();
+    for (size_t index = 0; index < count; ++index) {
+      const auto run = std::upper_bound(end_positions.cbegin(), end_positions.cend(), offsets[index]);
+      functor(values[run - end_positions.cbegin()], index);
+    }
+  }
+
+ protected:
+  const RunLengthSegment<T>* _segment;
+};
+
+template <typename T>
+class FrameOfReferenceSegmentIterable {
+ public:
+  explicit FrameOfReferenceSegmentIterable(const FrameOfReferenceSegment<T>& segment) : _segment{&segment} {}
+
+  template <typename Functor>
+  void for_each(const Functor& functor) const {
+    if constexpr (std::is_integral_v<T>) {
+      const auto minimum = static_cast<uint64_t>(_segment->minimum());
+      attribute_vector_for_each(*_segment->offsets(), [&](const uint32_t value_offset, const ChunkOffset offset) {
+        functor(static_cast<T>(minimum + value_offset), offset);
+      });
+    } else {
+      Fail("FrameOfReference encoding is only supported for integral types");
+    }
+  }
+
+  template <typename Functor>
+  void for_each_at(const ChunkOffset* offsets, const size_t count, const Functor& functor) const {
+    if constexpr (std::is_integral_v<T>) {
+      const auto minimum = static_cast<uint64_t>(_segment->minimum());
+      const auto& value_offsets = *_segment->offsets();
+      for (size_t index = 0; index < count; ++index) {
+        functor(static_cast<T>(minimum + value_offsets.get(offsets[index])), index);
+      }
+    } else {
+      Fail("FrameOfReference encoding is only supported for integral types");
+    }
+  }
+
+ protected:
+  const FrameOfReferenceSegment<T>* _segment;
+};
+
+template <typename T>
+ValueSegmentIterable<T> create_iterable(const ValueSegment<T>& segment) {
+  return ValueSegmentIterable<T>{segment};
+}
+
+template <typename T>
+DictionarySegmentIterable<T> create_iterable(const DictionarySegment<T>& segment) {
+  return DictionarySegmentIterable<T>{segment};
+}
+
+template <typename T>
+RunLengthSegmentIterable<T> create_iterable(const RunLengthSegment<T>& segment) {
+  return RunLengthSegmentIterable<T>{segment};
+}
+
+template <typename T>
+FrameOfReferenceSegmentIterable<T> create_iterable(const FrameOfReferenceSegment<T>& segment) {
+  return FrameOfReferenceSegmentIterable<T>{segment};
+}
+
+// Iterates over the values referenced by a ReferenceSegment whose referenced column has the data type T. The segments
+// of the referenced table are resolved when they are first referenced. Positions are processed in batches of
+// consecutive positions in the same chunk, so that the type of the referenced segment is resolved once per batch
+// rather than once per position. Thus, the positions found by a TableScan, which are ordered by chunk, are accessed in
+// tight loops. If the segment references a single chunk, its referenced segment is resolved once up front.
+template <typename T>
+class ReferenceSegmentIterable {
+ public:
+  explicit ReferenceSegmentIterable(const ReferenceSegment& segment) : _segment{&segment} {}
+
+  template <typename Functor>
+  void for_each(const Functor& functor) const {
+    ChunkOffset position{0};
+    for_each_referenced([&](const auto& value, const RowID&) { functor(value, position++); });
+  }
+
+  // same as for_each, but calls functor(value, row_id) with the referenced row instead of the position
+  template <typename Functor>
+  void for_each_referenced(const Functor& functor) const {
+    if (_segment->references_single_chunk()) {
+      _for_each_referenced_in_single_chunk(functor);
+      return;
+    }
+
+    const auto& table = *_segment->referenced_table();
+    std::vector<std::optional<DataSegmentIterable>> iterables(table.chunk_count());
+    // The iterables do not own their segments, which might be replaced by a compression of their chunk meanwhile
+    std::vector<std::shared_ptr<const BaseSegment>> referenced_segments(table.chunk_count());
+
+    std::array<RowID, BATCH_SIZE> row_ids;
+    std::array<ChunkOffset, BATCH_SIZE> offsets;
+    size_t count = 0;
+    const auto process_batch = [&] {
+      const auto chunk_id = row_ids[0].chunk_id;
+      if (!iterables[chunk_id]) {
+        referenced_segments[chunk_id] = table.get_chunk(chunk_id).get_segment(_segment->referenced_column_id());
+        iterables[chunk_id] = _create_data_segment_iterable(*referenced_segments[chunk_id]);
+      }
+      std::visit(
+          [&](const auto& iterable) {
+            iterable.for_each_at(offsets.data(), count,
+                                 [&](const auto& value, const size_t index) { functor(value, row_ids[index]); });
+          },
+          *iterables[chunk_id]);
+      count = 0;
+    };
+
+    _segment->for_each_row_id([&](const RowID& row_id) {
+      if (count == BATCH_SIZE || (count > 0 && row_ids[0].chunk_id != row_id.chunk_id)) process_batch();
+      row_ids[count] = row_id;
+      offsets[count] = row_id.chunk_offset;
+      ++count;
+    });
+    if (count > 0) process_batch();
+  }
+
+ protected:
+  static constexpr size_t BATCH_SIZE = 512;
+
+  using DataSegmentIterable = std::variant<ValueSegmentIterable<T>, DictionarySegmentIterable<T>,
+                                           RunLengthSegmentIterable<T>, FrameOfReferenceSegmentIterable<T>>;
+
+  template <typename Functor>
+  void _for_each_referenced_in_single_chunk(const Functor& functor) const {
+    if (_segment->size() == 0) return;
+
+    const auto& table = *_segment->referenced_table();
+    const auto first_row_id = _segment->pos_list() ? (*_segment->pos_list())[0] : (*_segment->row_id_bitmap())[0];
+    const auto chunk_id = first_row_id.chunk_id;
+    const auto referenced_segment = table.get_chunk(chunk_id).get_segment(_segment->referenced_column_id());
+
+    std::visit(
+        [&](const auto& iterable) {
+          std::array<ChunkOffset, BATCH_SIZE> offsets;
+          size_t count = 0;
+          const auto process_batch = [&] {
+            iterable.for_each_at(offsets.data(), count, [&](const auto& value, const size_t index) {
+              functor(value, RowID{chunk_id, offsets[index]});
+            });
+            count = 0;
+          };
+
+          _segment->for_each_row_id([&](const RowID& row_id) {
+            if (count == BATCH_SIZE) process_batch();
+            offsets[count++] = row_id.chunk_offset;
+          });
+          if (count > 0) process_batch();
+        },
+        _create_data_segment_iterable(*referenced_segment));
+  }
+
+  static DataSegmentIterable _create_data_segment_iterable(const BaseSegment& segment) {
+    std::optional<DataSegmentIterable> iterable;
+    resolve_segment_type<T>(segment, [&](const auto& typed_segment) {
+      if constexpr (std::is_same_v<std::decay_t<decltype(typed_segment)>, ReferenceSegment>) {
+        Fail("ReferenceSegments cannot reference other ReferenceSegments");
+      } else {
+        iterable = create_iterable(typed_segment);
+      }
+    });
+    return *iterable;
+  }
+
+  const ReferenceSegment* _segment;
+};
+
+template <typename T>
+ReferenceSegmentIterable<T> create_iterable(const ReferenceSegment& segment) {
+  return ReferenceSegmentIterable<T>{segment};
+}
+
+// Resolves the type of a segment of data type T and calls functor(value, position) for all of its values, see above
+template <typename T, typename Functor>
+void segment_for_each(const BaseSegment& segment, const Functor& functor) {
+  resolve_segment_type<T>(segment, [&](const auto& typed_segment) {
+    if constexpr (std::is_same_v<std::decay_t<decltype(typed_segment)>, ReferenceSegment>) {
+      create_iterable<T>(typed_segment).for_each(functor);
+    } else {
+      create_iterable(typed_segment).for_each(functor);
+    }
+  });
+}
+
+// same as segment_for_each<T>, but resolves the data type given as a string first
+template <typename Functor>
+void segment_for_each(const std::string& data_type, const BaseSegment& segment, const Functor& functor) {
+  resolve_data_type(data_type, [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+    segment_for_each<ColumnDataType>(segment, functor);
+  });
+}
+
+}  // namespace opossum
@@ -1,14 +1,25 @@
 #include "storage_manager.hpp"
 
+#include <filesystem>
+#include <fstream>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "segment_encoding_utils.hpp"
 #include "utils/assert.hpp"
+#include "utils/binary_table.hpp"
 
 namespace opossum {
 
+namespace {
+
+constexpr auto CATALOG_FILE_NAME = "catalog";
+
+}  // namespace
+
 StorageManager& StorageManager::get() {
   static StorageManager instance;
   return instance;
@@ -39,10 +50,63 @@ std::vector<std::string> StorageManager::table_names() const {
 }
 
 void StorageManager::print(std::ostream& out) const {
-  out << "NAME, COLUMNS, ROWS, CHUNKS\n";
+  out << "NAME, COLUMNS, ROWS, CHUNKS, BYTES\n";
   for (const auto& [key, _] : _name_table_map) {
     const auto& table = _name_table_map.at(key);
-    out << key << "\t" << table->column_count() << "\t" << table->row_count() << "\t" << table->chunk_count() << "\n";
+    out << key << "\t" << table->column_count() << "\t" << table->row_count() << "\t" << table->chunk_count() << "\t"
+        << table->estimate_memory_usage() << "\n";
+
+    // Below each table, list the number of segments and their bytes for each encoding found in a column
+    out << "\tCOLUMN, TYPE, ENCODING, SEGMENTS, BYTES\n";
+    for (ColumnID column_id{0}; column_id < table->column_count(); ++column_id) {
+      const auto& column_type = table->column_type(column_id);
+      auto segments_by_encoding = std::map<std::string, std::pair<size_t, size_t>>{};
+      for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+        const auto segment = table->get_chunk(chunk_id).get_segment(column_id);
+        auto& segments = segments_by_encoding[segment_encoding_name(column_type, segment)];
+        ++segments.first;
+        segments.second += segment->estimate_memory_usage();
+      }
+
+      for (const auto& [encoding, segments] : segments_by_encoding) {
+        out << "\t" << table->column_name(column_id) << "\t" << column_type << "\t" << encoding << "\t"
+            << segments.first << "\t" << segments.second << "\n";
+      }
+    }
+  }
+}
+
+void StorageManager::export_tables(const std::string& directory) const {
+  const auto directory_path = std::filesystem::path(directory);
+  std::filesystem::create_directories(directory_path);
+
+  // Table names may contain characters that are not allowed in file names, so the files are numbered instead. Each
+  // line of the catalog holds the file name and the table name.
+  auto catalog = std::ofstream{directory_path / CATALOG_FILE_NAME};
+  Assert(catalog.is_open(), "Could not create catalog in " + directory);
+  auto table_index = size_t{0};
+  for (const auto& name_table : _name_table_map) {
+    Assert(name_table.first.find('\n') == std::string::npos, "Cannot export table names containing line breaks");
+    const auto file_name = "table_" + std::to_string(table_index++) + ".bin";
+    write_binary_table(*name_table.second, directory_path / file_name);
+    catalog << file_name << ' ' << name_table.first << '\n';
+  }
+  catalog.flush();
+  Assert(catalog.good(), "Could not write catalog in " + directory);
+}
+
+void StorageManager::import_tables(const std::string& directory) {
+  const auto directory_path = std::filesystem::path(directory);
+  auto catalog = std::ifstream{directory_path / CATALOG_FILE_NAME};
+  Assert(catalog.is_open(), "Could not find catalog in " + directory);
+
+  auto line = std::string{};
+  while (std::getline(catalog, line)) {
+    const auto separator = line.find(' ');
+    Assert(separator != std::string::npos, "Invalid catalog in " + directory);
+    const auto name = line.substr(separator + 1);
+    Assert(!has_table(name), "Table " + name + " already exists");
+    add_table(name, read_binary_table(directory_path / line.substr(0, separator)));
   }
 }
 
@@ -32,9 +32,20 @@ class StorageManager : private Noncopyable {
   // returns a list of all table names
   std::vector<std::string> table_names() const;
 
-  // prints information about all tables in the storage manager (name, #columns, #rows, #chunks)
+  // prints information about all tables in the storage manager (name, #columns, #rows, #chunks, #bytes), and the
+  // number of segments and bytes per encoding for each column
   void print(std::ostream& out = std::cout) const;
 
+  // Writes all tables to the given directory, which is created if necessary. Each table is stored in a file of its own,
+  // see write_binary_table, and a catalog file lists the names of the tables. Existing files are replaced rather than
+  // overwritten, so the directory may be the one that imported tables are mapped from.
+  void export_tables(const std::string& directory) const;
+
+  // Adds all tables of a directory written by export_tables. The files are mapped into memory, and the attribute
+  // vectors of encoded segments reference them. The values of ValueSegments, dictionaries, runs, and membership filters
+  // are copied, though without parsing or encoding any values. See read_binary_table.
+  void import_tables(const std::string& directory);
+
   // deletes the entire StorageManager and creates a new one, used especially in tests
   static void reset();
 
@@ -0,0 +1,72 @@
+#include "string_heap.hpp"
+
+#include <algorithm>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <utility>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+StringHeap::StringHeap(std::initializer_list<std::string_view> strings) {
+  auto bytes = size_t{0};
+  for (const auto& string : strings) bytes += string.size();
+  reserve(strings.size(), bytes);
+  for (const auto& string : strings) emplace_back(string);
+}
+
+StringHeap::StringHeap(const allocator_type& allocator) : _bytes{allocator}, _offsets(1, size_t{0}, allocator) {}
+
+StringHeap::StringHeap(std::pmr::vector<char> bytes, std::pmr::vector<size_t> offsets)
+    : _bytes{std::move(bytes)}, _offsets{std::move(offsets)} {
+  Assert(!_offsets.empty() && _offsets.front() == 0 && _offsets.back() == _bytes.size(),
+         "Offsets do not match the bytes of the StringHeap");
+}
+
+void StringHeap::emplace_back(const std::string_view string) {
+  _bytes.insert(_bytes.end(), string.begin(), string.end());
+  _offsets.emplace_back(_bytes.size());
+}
+
+void StringHeap::append(const StringHeap& other, const size_t begin, const size_t end) {
+  DebugAssert(begin <= end && end <= other.size(), "Range out of bounds");
+  const auto first_byte = other._offsets[begin];
+  const auto byte_count_before = _bytes.size();
+  _bytes.insert(_bytes.end(), other._bytes.begin() + first_byte, other._bytes.begin() + other._offsets[end]);
+  for (auto position = begin + 1; position <= end; ++position) {
+    _offsets.emplace_back(other._offsets[position] - first_byte + byte_count_before);
+  }
+}
+
+void StringHeap::reserve(const size_t count, const size_t bytes) {
+  _offsets.reserve(count + 1);
+  _bytes.reserve(bytes);
+}
+
+void StringHeap::append_placeholders(const size_t count, const size_t bytes) {
+  // All placeholders but the first one are empty until they are written
+  _offsets.resize(_offsets.size() + count, _bytes.size() + bytes);
+  _bytes.resize(_bytes.size() + bytes);
+}
+
+void StringHeap::write(const size_t index, const StringHeap& other, const size_t begin, const size_t end) {
+  // size() is not used, since other threads may add placeholders concurrently
+  const auto first_byte = other._offsets[begin];
+  const auto first_target_byte = _offsets[index];
+  DebugAssert(begin <= end && end <= other.size(), "Range out of bounds");
+  DebugAssert(_offsets[index + end - begin] - first_target_byte == other._offsets[end] - first_byte,
+              "Placeholders do not match the length of the strings");
+  std::copy(other._bytes.begin() + first_byte, other._bytes.begin() + other._offsets[end],
+            _bytes.begin() + first_target_byte);
+  for (auto position = begin + 1; position < end; ++position) {
+    _offsets[index + position - begin] = other._offsets[position] - first_byte + first_target_byte;
+  }
+}
+
+void StringHeap::shrink_to_fit() {
+  _offsets.shrink_to_fit();
+  _bytes.shrink_to_fit();
+}
+
+}  // namespace opossum
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>  // NOLINT(build/include_order)
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <type_traits>
+#include <vector>
+
+namespace opossum {
+
+// StringHeap stores a sequence of strings back to back in a single byte buffer. An offset array marks where each string
+// starts, so that string i occupies the bytes [_offsets[i], _offsets[i + 1]). Compared to a std::vector<std::string>,
+// this avoids a heap allocation for every string that does not fit into the small string buffer, and scans read the
+// strings sequentially from memory instead of chasing a pointer for each one.
+//
+// Strings are accessed as std::string_view. The views are invalidated by the next call to a non-const method.
+class StringHeap {
+ public:
+  using value_type = std::string_view;
+  using const_reference = std::string_view;
+  using size_type = size_t;
+  using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+  // Random access iterator over all strings. Dereferencing returns a std::string_view into the heap.
+  class const_iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = std::string_view;
+
+    const_iterator() = default;
+    const_iterator(const StringHeap* heap, size_t index) : _heap{heap}, _index{index} {}
+
+    std::string_view operator*() const { return (*_heap)[_index]; }
+    std::string_view operator[](difference_type n) const { return (*_heap)[_index + n]; }
+
+    const_iterator& operator++() {
+      ++_index;
+      return *this;
+    }
+    const_iterator operator++(int) { return {_heap, _index++}; }
+    const_iterator& operator--() {
+      --_index;
+      return *this;
+    }
+    const_iterator operator--(int) { return {_heap, _index--}; }
+    const_iterator& operator+=(difference_type n) {
+      _index += n;
+      return *this;
+    }
+    const_iterator& operator-=(difference_type n) {
+      _index -= n;
+      return *this;
+    }
+    const_iterator operator+(difference_type n) const { return {_heap, _index + n}; }
+    const_iterator operator-(difference_type n) const { return {_heap, _index - n}; }
+    friend const_iterator operator+(difference_type n, const const_iterator& it) { return it + n; }
+    difference_type operator-(const const_iterator& other) const {
+      return static_cast<difference_type>(_index) - static_cast<difference_type>(other._index);
+    }
+
+    bool operator==(const const_iterator& other) const { return _index == other._index; }
+    bool operator!=(const const_iterator& other) const { return _index != other._index; }
+    bool operator<(const const_iterator& other) const { return _index < other._index; }
+    bool operator<=(const const_iterator& other) const { return _index <= other._index; }
+    bool operator>(const const_iterator& other) const { return _index > other._index; }
+    bool operator>=(const const_iterator& other) const { return _index >= other._index; }
+
+   private:
+    const StringHeap* _heap{nullptr};
+    size_t _index{0};
+  };
+
+  StringHeap() = default;
+  StringHeap(std::initializer_list<std::string_view> strings);
+
+  // creates an empty heap that allocates its buffers from the memory resource of the given allocator
+  explicit StringHeap(const allocator_type& allocator);
+
+  // Creates a heap from the buffers returned by bytes() and offsets() of another heap. The offsets start with 0 and
+  // end with the number of bytes.
+  StringHeap(std::pmr::vector<char> bytes, std::pmr::vector<size_t> offsets);
+
+  // returns the allocator of the buffers
+  allocator_type get_allocator() const { return _bytes.get_allocator(); }
+
+  // return the string at a certain position
+  std::string_view operator[](const size_t i) const {
+    return std::string_view{_bytes.data() + _offsets[i], _offsets[i + 1] - _offsets[i]};
+  }
+
+  // return the last string
+  std::string_view back() const { return (*this)[size() - 1]; }
+
+  // add a string to the end. Named like the std::vector method so that both can be filled by the same code.
+  void emplace_back(std::string_view string);
+  void push_back(std::string_view string) { emplace_back(string); }
+
+  // add the strings at positions [begin, end) of another heap to the end
+  void append(const StringHeap& other, size_t begin, size_t end);
+
+  // reserve space for `count` strings with a total length of `bytes`
+  void reserve(size_t count, size_t bytes = 0);
+
+  // Adds `count` strings with a total length of `bytes`, which are overwritten later by write(). As long as they fit
+  // into the reserved space, this does not allocate memory and does not move the strings already in the heap.
+  void append_placeholders(size_t count, size_t bytes);
+
+  // Overwrites the placeholders starting at position `index` with the strings at positions [begin, end) of another
+  // heap. The placeholders must have been added by a single call of append_placeholders with the length of these
+  // strings. Different ranges of placeholders can be written by multiple threads concurrently.
+  void write(size_t index, const StringHeap& other, size_t begin, size_t end);
+
+  // release unused capacity of both buffers
+  void shrink_to_fit();
+
+  // return the number of strings
+  size_t size() const { return _offsets.size() - 1; }
+
+  bool empty() const { return _offsets.size() == 1; }
+
+  // return the total length of all strings
+  size_t byte_count() const { return _bytes.size(); }
+
+  // return the number of strings and the total length of the strings that fit into the reserved space
+  size_t capacity() const { return _offsets.capacity() - 1; }
+  size_t byte_capacity() const { return _bytes.capacity(); }
+
+  // return the strings back to back
+  const std::pmr::vector<char>& bytes() const { return _bytes; }
+
+  // return the offset of each string in bytes(), followed by the number of bytes
+  const std::pmr::vector<size_t>& offsets() const { return _offsets; }
+
+  // return the number of bytes allocated for the strings and their offsets
+  size_t estimate_memory_usage() const { return _bytes.capacity() + _offsets.capacity() * sizeof(size_t); }
+
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator end() const { return {this, size()}; }
+
+  bool operator==(const StringHeap& other) const { return _bytes == other._bytes && _offsets == other._offsets; }
+  bool operator!=(const StringHeap& other) const { return !(*this == other); }
+
+ protected:
+  std::pmr::vector<char> _bytes;
+  std::pmr::vector<size_t> _offsets{0};
+};
+
+// The container used by segments to store values of type T. Strings are stored in a StringHeap, all other types in a
+// std::pmr::vector. Both provide operator[], size(), iterators and emplace_back(), so that code can be shared between
+// them, and can be constructed from a std::pmr::memory_resource to allocate their memory from.
+// Note that the elements of a StringHeap are std::string_views, so ValueVector<T>::const_reference should be used
+// instead of const T&.
+template <typename T>
+using ValueVector = std::conditional_t<std::is_same_v<T, std::string>, StringHeap, std::pmr::vector<T>>;
+
+}  // namespace opossum
@@ -1,23 +1,40 @@
 #include "table.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
 #include <iomanip>
 #include <limits>
 #include <memory>
-#include <numeric>
+#include <mutex>
+#include <shared_mutex>  // NOLINT(build/include_order)
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
-#include "dictionary_segment.hpp"
+#include "compression_service.hpp"
+#include "reference_segment.hpp"
 #include "resolve_type.hpp"
+#include "segment_encoding_utils.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
+#include "utils/parallel.hpp"
 #include "value_segment.hpp"
+#include "zone_map.hpp"
 
 namespace opossum {
 
-Table::Table(const uint32_t chunk_size) : _chunk_size{chunk_size} { create_new_chunk(); }
+Table::Table(const uint32_t chunk_size)
+    : _chunk_size{chunk_size == 0 ? std::numeric_limits<ChunkOffset>::max() - 1 : chunk_size} {
+  Assert(_chunk_size < std::numeric_limits<ChunkOffset>::max(), "Chunk size too large");
+  create_new_chunk();
+}
+
+// The workers access the table, so they are stopped before any other member is destroyed
+Table::~Table() { _compression_service = nullptr; }
 
 void Table::add_column_definition(const std::string& name, const std::string& type) {
   DebugAssert(row_count() == 0, "Columns can only be appended to empty tables");
@@ -29,40 +46,238 @@ void Table::add_column_definition(const std::string& name, const std::string& ty
 
 void Table::add_column(const std::string& name, const std::string& type) {
   add_column_definition(name, type);
-  _chunks.front().add_segment(make_shared_by_data_type<BaseSegment, ValueSegment>(type));
+  get_chunk(ChunkID{0}).add_segment(make_shared_by_data_type<BaseSegment, ValueSegment>(type));
 }
 
-void Table::append(std::vector<AllTypeVariant> values) {
-  DebugAssert(values.size() == column_count(), "Number of passed arguments does not match number of columns");
-  auto& mutable_chunk = _chunks.back();
-  mutable_chunk.append(std::move(values));
-  if (mutable_chunk.size() == _chunk_size) {
-    create_new_chunk();
+void Table::append(std::vector<AllTypeVariant> values) { append_rows({std::move(values)}); }
+
+void Table::append_rows(const std::vector<std::vector<AllTypeVariant>>& rows) {
+  // The values are converted before any row is reserved, so that invalid values cannot leave reserved rows unwritten
+  std::vector<std::shared_ptr<BaseSegment>> segments;
+  for (const auto& type : _column_types) {
+    segments.emplace_back(make_shared_by_data_type<BaseSegment, ValueSegment>(type));
+  }
+  for (const auto& values : rows) {
+    Assert(values.size() == column_count(), "Number of passed arguments does not match number of columns");
+    for (ColumnID column_id{0}; column_id < values.size(); ++column_id) {
+      segments[column_id]->append(values[column_id]);
+    }
+  }
+
+  _append_segments(segments);
+}
+
+void Table::_append_segments(const std::vector<std::shared_ptr<BaseSegment>>& segments) {
+  Assert(segments.size() == column_count(), "Number of passed columns does not match number of columns");
+  const auto row_count = segments.empty() ? size_t{0} : segments.front()->size();
+  for (ColumnID column_id{0}; column_id < segments.size(); ++column_id) {
+    Assert(segments[column_id]->size() == row_count, "All columns must have the same number of values");
+    resolve_data_type(_column_types[column_id], [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      Assert(std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(segments[column_id]),
+             "Values do not match the type of column " + _column_names[column_id]);
+    });
+  }
+
+  // The rows may span multiple chunks
+  auto first_row = size_t{0};
+  while (first_row < row_count) {
+    const auto rows = _reserve_rows(segments, first_row);
+    if (!rows.written) {
+      _write_rows(rows, segments, first_row);
+    }
+    first_row += rows.end - rows.begin;
+    _finish_rows(rows);
+  }
+}
+
+Table::RowRange Table::_reserve_rows(const std::vector<std::shared_ptr<BaseSegment>>& segments,
+                                     const size_t first_row) {
+  auto lock = std::lock_guard{_append_mutex};
+
+  // The writer that reserved the last rows of the mutable chunk did not create the next one yet. A chunk that was
+  // compressed, e.g., by compress_chunk or because it was emplaced encoded, is not appended to either.
+  if (_reserved_row_count == _chunk_size || _is_compressed(_mutable_chunk_id)) {
+    _create_mutable_chunk();
+  }
+
+  const auto row_count = segments.front()->size() - first_row;
+  const auto begin = _reserved_row_count;
+  const auto end = static_cast<ChunkOffset>(std::min(size_t{_chunk_size}, begin + row_count));
+  const auto& chunk = get_chunk(_mutable_chunk_id);
+
+  // The length of the strings of each column, and whether the values can be moved into the empty mutable chunk. This
+  // requires the memory resources to match, so that moving them cannot fail.
+  std::vector<size_t> byte_counts(segments.size());
+  auto move_values = begin == 0 && first_row == 0 && end - begin == row_count;
+  auto grow = false;
+  for (ColumnID column_id{0}; column_id < segments.size(); ++column_id) {
+    resolve_data_type(_column_types[column_id], [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      const auto& source = static_cast<const ValueSegment<ColumnDataType>&>(*segments[column_id]);
+      const auto segment = std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(chunk.get_segment(column_id));
+      Assert(segment, "Cannot append to a chunk with encoded segments");
+      if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+        const auto& offsets = source.values().offsets();
+        byte_counts[column_id] = offsets[first_row + end - begin] - offsets[first_row];
+      }
+      move_values &= segment->memory_resource() == source.memory_resource();
+      grow |= !segment->has_capacity_for(end - begin, byte_counts[column_id]);
+    });
+  }
+
+  if (move_values) {
+    for (ColumnID column_id{0}; column_id < segments.size(); ++column_id) {
+      resolve_data_type(_column_types[column_id], [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        auto& source = static_cast<ValueSegment<ColumnDataType>&>(*segments[column_id]);
+        auto& segment = static_cast<ValueSegment<ColumnDataType>&>(*chunk.get_segment(column_id));
+        segment.append_values(source.release_values());
+      });
+    }
+    _reserved_row_count = end;
+    return RowRange{_mutable_chunk_id, begin, end, true};
+  }
+
+  // Other writers may be writing to the placeholders of the segments, which move when more memory is allocated. The
+  // memory is doubled, so that this happens a logarithmic number of times per chunk. If allocating fails, only the
+  // capacity of some segments changed, and no rows are reserved.
+  if (grow) {
+    auto storage_lock = std::unique_lock{_storage_mutex};
+    const auto capacity = std::min(size_t{_chunk_size}, std::max(size_t{end}, size_t{2} * begin));
+    for (ColumnID column_id{0}; column_id < segments.size(); ++column_id) {
+      const auto& segment = chunk.get_segment(column_id);
+      resolve_data_type(_column_types[column_id], [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        auto& typed_segment = static_cast<ValueSegment<ColumnDataType>&>(*segment);
+        if (typed_segment.has_capacity_for(end - begin, byte_counts[column_id])) return;
+        if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+          typed_segment.reserve(capacity, 2 * (typed_segment.values().byte_count() + byte_counts[column_id]));
+        } else {
+          typed_segment.reserve(capacity);
+        }
+      });
+    }
+  }
+
+  // Adding placeholders to the reserved memory does not fail
+  for (ColumnID column_id{0}; column_id < segments.size(); ++column_id) {
+    resolve_data_type(_column_types[column_id], [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      static_cast<ValueSegment<ColumnDataType>&>(*chunk.get_segment(column_id))
+          .append_placeholders(end - begin, byte_counts[column_id]);
+    });
+  }
+  _reserved_row_count = end;
+  return RowRange{_mutable_chunk_id, begin, end, false};
+}
+
+void Table::_write_rows(const RowRange& rows, const std::vector<std::shared_ptr<BaseSegment>>& segments,
+                        const size_t first_row) noexcept {
+  // Prevents the placeholders from being moved by _reserve_rows while they are written
+  auto lock = std::shared_lock{_storage_mutex};
+
+  const auto& chunk = get_chunk(rows.chunk_id);
+  const auto row_count = size_t{rows.end - rows.begin};
+  for (ColumnID column_id{0}; column_id < segments.size(); ++column_id) {
+    resolve_data_type(_column_types[column_id], [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      const auto& source = static_cast<const ValueSegment<ColumnDataType>&>(*segments[column_id]);
+      static_cast<ValueSegment<ColumnDataType>&>(*chunk.get_segment(column_id))
+          .write_values(rows.begin, source.values(), first_row, first_row + row_count);
+    });
+  }
+}
+
+void Table::_finish_rows(const RowRange& rows) {
+  const auto row_count = rows.end - rows.begin;
+  _row_count += row_count;
+
+  auto& slot = _chunk_slot(rows.chunk_id);
+  if (slot.written_row_count.fetch_add(row_count) + row_count == _chunk_size) {
+    _seal_chunk(rows.chunk_id);
+  }
+
+  // Writers reserving rows in the meantime create the next chunk themselves
+  if (rows.end == _chunk_size) {
+    auto lock = std::lock_guard{_append_mutex};
+    if (_mutable_chunk_id == rows.chunk_id && _reserved_row_count == _chunk_size) {
+      _create_mutable_chunk();
+    }
+  }
+}
+
+void Table::_seal_chunk(const ChunkID chunk_id) {
+  // Chunks added using emplace_chunk may have zone maps already
+  const auto& full_chunk = get_chunk(chunk_id);
+  if (full_chunk.column_count() > 0 && !full_chunk.get_zone_map(ColumnID{0})) {
+    std::vector<std::shared_ptr<BaseSegment>> segments;
+    for (ColumnID column_id{0}; column_id < full_chunk.column_count(); ++column_id) {
+      segments.emplace_back(full_chunk.get_segment(column_id));
+    }
+    auto zone_maps = _build_zone_maps(segments);
+
+    // compress_chunk might replace the segments and zone maps concurrently
+    auto guard = std::lock_guard{_compression_mutex};
+    get_chunk(chunk_id).set_zone_maps(zone_maps);
+  }
+
+  if (_compression_service) {
+    _compression_service->enqueue(chunk_id);
   }
 }
 
 void Table::create_new_chunk() {
+  auto lock = std::lock_guard{_append_mutex};
+  _create_mutable_chunk();
+}
+
+void Table::_create_mutable_chunk() {
   Chunk chunk;
   for (const auto& type : _column_types) {
     chunk.add_segment(make_shared_by_data_type<BaseSegment, ValueSegment>(type));
   }
+  _add_chunk(std::move(chunk), false);
+  _mutable_chunk_id = ChunkID{chunk_count() - 1};
+  _reserved_row_count = 0;
+}
 
-  {
-    auto guard = std::lock_guard{_compression_mutex};
-    _chunks.emplace_back(std::move(chunk));
-    _compressed_chunks.emplace_back(false);
+void Table::_add_chunk(Chunk&& chunk, const bool is_compressed) {
+  auto guard = std::lock_guard{_compression_mutex};
+  const auto chunk_id = ChunkID{_chunk_count.load()};
+  Assert(chunk_id + uint64_t{1} < std::numeric_limits<uint32_t>::max(), "Too many chunks");
+
+  // The block of chunk i is the position of the highest bit set in i + 1
+  const auto block_id = 63 - __builtin_clzll(uint64_t{chunk_id} + 1);
+  if (!_chunk_blocks[block_id]) {
+    _chunk_blocks[block_id] = std::make_unique<ChunkSlot[]>(size_t{1} << block_id);
   }
+  _compressed_chunks.emplace_back(is_compressed);
+  _chunk_slot(chunk_id).chunk = std::move(chunk);
+
+  // Readers that see the new count see the chunk as well
+  _chunk_count = chunk_id + 1;
+}
+
+Table::ChunkSlot& Table::_chunk_slot(const ChunkID chunk_id) const {
+  const auto index = uint64_t{chunk_id} + 1;
+  const auto block_id = 63 - __builtin_clzll(index);
+  return _chunk_blocks[block_id][index - (uint64_t{1} << block_id)];
 }
 
 uint16_t Table::column_count() const { return static_cast<uint16_t>(_name_column_map.size()); }
 
-uint64_t Table::row_count() const {
-  DebugAssert(!_chunks.empty(), "There should always be at least one chunk");
-  return std::accumulate(_chunks.begin(), _chunks.end(), uint64_t{0},
-                         [](const auto sum, const Chunk& chunk) { return sum + chunk.size(); });
+uint64_t Table::row_count() const { return _row_count; }
+
+size_t Table::estimate_memory_usage() const {
+  auto bytes = sizeof(*this);
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count(); ++chunk_id) {
+    bytes += get_chunk(chunk_id).estimate_memory_usage();
+  }
+  return bytes;
 }
 
-ChunkID Table::chunk_count() const { return ChunkID{static_cast<uint32_t>(_chunks.size())}; }
+ChunkID Table::chunk_count() const { return ChunkID{_chunk_count.load()}; }
 
 ColumnID Table::column_id_by_name(const std::string& column_name) const {
   auto id_it = _name_column_map.find(column_name);
@@ -86,44 +301,252 @@ const std::string& Table::column_type(ColumnID column_id) const {
 
 Chunk& Table::get_chunk(ChunkID chunk_id) {
   DebugAssert(chunk_id < chunk_count(), "Chunk id out of range");
-  return _chunks[chunk_id];
+  return _chunk_slot(chunk_id).chunk;
 }
 
 const Chunk& Table::get_chunk(ChunkID chunk_id) const {
   DebugAssert(chunk_id < chunk_count(), "Chunk id out of range");
-  return _chunks[chunk_id];
+  return _chunk_slot(chunk_id).chunk;
 }
 
 void Table::emplace_chunk(Chunk&& chunk) {
   DebugAssert(chunk.column_count() == column_count(), "chunk and table must have equal column count for emplace");
+  const auto row_count = chunk.size();
 
-  if (_chunks.back().size() == 0) {
-    _chunks.back() = std::move(chunk);
-  } else {
-    _chunks.emplace_back(std::move(chunk));
+  // Chunks consisting of encoded segments only, e.g., those read by read_binary_table, are compressed already
+  auto is_compressed = chunk.column_count() > 0;
+  for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
+    const auto segment = chunk.get_segment(column_id);
+    resolve_data_type(column_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      if (std::dynamic_pointer_cast<const ValueSegment<ColumnDataType>>(segment) ||
+          std::dynamic_pointer_cast<const ReferenceSegment>(segment)) {
+        is_compressed = false;
+      }
+    });
   }
-}
 
-void Table::compress_chunk(ChunkID chunk_id) {
   {
-    auto guard = std::lock_guard{_compression_mutex};
-    if (_compressed_chunks[chunk_id]) {
-      return;
+    auto lock = std::lock_guard{_append_mutex};
+    auto& last_slot = _chunk_slot(ChunkID{chunk_count() - 1});
+    if (last_slot.chunk.size() == 0) {
+      auto guard = std::lock_guard{_compression_mutex};
+      last_slot.chunk = std::move(chunk);
+      _compressed_chunks.back() = is_compressed;
+    } else {
+      _add_chunk(std::move(chunk), is_compressed);
+    }
+
+    // Emplaced chunks may be larger than the chunk size
+    _mutable_chunk_id = ChunkID{chunk_count() - 1};
+    _reserved_row_count = std::min(row_count, _chunk_size);
+    _chunk_slot(_mutable_chunk_id).written_row_count = _reserved_row_count;
+  }
+  _row_count += row_count;
+
+  if (row_count >= _chunk_size) {
+    _seal_chunk(ChunkID{chunk_count() - 1});
+  }
+}
+
+void Table::compress_chunk(ChunkID chunk_id, EncodingType encoding_type) {
+  compress_chunk(chunk_id, ChunkEncodingSpec(column_count(), encoding_type));
+}
+
+void Table::compress_chunk(ChunkID chunk_id, const ChunkEncodingSpec& encoding_spec) {
+  DebugAssert(encoding_spec.size() == column_count(), "Number of encodings does not match number of columns");
+  std::vector<std::shared_ptr<BaseSegment>> segments;
+  std::vector<std::shared_ptr<const BaseZoneMap>> zone_maps;
+  if (!_begin_compression(chunk_id, segments, zone_maps)) {
+    return;
+  }
+
+  // The segments are encoded without holding the mutex, so that multiple chunks can be compressed in parallel
+  std::vector<std::shared_ptr<BaseSegment>> encoded_segments;
+  try {
+    if (zone_maps.empty()) {
+      zone_maps = _build_zone_maps(segments);
+    }
+    for (ColumnID column_id{0}; column_id < segments.size(); ++column_id) {
+      const auto& column_type = _column_types[column_id];
+      encoded_segments.emplace_back(encode_segment(encoding_spec[column_id], column_type, segments[column_id]));
+    }
+  } catch (...) {
+    _abort_compression(chunk_id);
+    throw;
+  }
+  _finish_compression(chunk_id, encoded_segments, zone_maps);
+}
+
+std::vector<ChunkCompressionStatistics> Table::compress(const ChunkEncodingSpec& encoding_spec,
+                                                        const size_t thread_count) {
+  Assert(encoding_spec.size() == column_count(), "Number of encodings does not match number of columns");
+
+  // A chunk whose segments are encoded by different threads. The thread encoding its last segment replaces it.
+  struct PendingChunk {
+    ChunkID chunk_id{0};
+    std::vector<std::shared_ptr<BaseSegment>> segments;
+    std::vector<std::shared_ptr<BaseSegment>> encoded_segments;
+    std::vector<std::shared_ptr<const BaseZoneMap>> zone_maps;
+    bool build_zone_maps{false};
+    std::vector<std::chrono::nanoseconds> encoding_durations;
+    std::atomic<size_t> remaining_segment_count{0};
+    std::atomic<bool> failed{false};
+    ChunkCompressionStatistics statistics{};
+  };
+
+  // Claim all chunks first. The deque does not move its elements, which the atomic counters could not handle.
+  std::deque<PendingChunk> pending_chunks;
+  std::vector<std::pair<size_t, ColumnID>> tasks;
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count(); ++chunk_id) {
+    if (get_chunk(chunk_id).size() == 0) continue;
+
+    auto& pending_chunk = pending_chunks.emplace_back();
+    if (!_begin_compression(chunk_id, pending_chunk.segments, pending_chunk.zone_maps)) {
+      pending_chunks.pop_back();
+      continue;
+    }
+
+    const auto segment_count = pending_chunk.segments.size();
+    pending_chunk.chunk_id = chunk_id;
+    pending_chunk.encoded_segments.resize(segment_count);
+    pending_chunk.build_zone_maps = pending_chunk.zone_maps.empty();
+    pending_chunk.zone_maps.resize(segment_count);
+    pending_chunk.encoding_durations.resize(segment_count);
+    pending_chunk.remaining_segment_count = segment_count;
+    for (ColumnID column_id{0}; column_id < segment_count; ++column_id) {
+      tasks.emplace_back(pending_chunks.size() - 1, column_id);
+    }
+  }
+
+  // Tasks are ordered by chunk, so that the threads finish one chunk after another and the memory of the uncompressed
+  // segments is released early
+  run_in_parallel(tasks.size(), thread_count, [&](const size_t task_index) {
+    auto& pending_chunk = pending_chunks[tasks[task_index].first];
+    const auto column_id = tasks[task_index].second;
+    const auto& segment = pending_chunk.segments[column_id];
+
+    try {
+      const auto begin = std::chrono::steady_clock::now();
+      pending_chunk.encoded_segments[column_id] =
+          encode_segment(encoding_spec[column_id], _column_types[column_id], segment);
+      if (pending_chunk.build_zone_maps) {
+        pending_chunk.zone_maps[column_id] = _build_zone_map(column_id, segment);
+      }
+      pending_chunk.encoding_durations[column_id] = std::chrono::steady_clock::now() - begin;
+    } catch (...) {
+      // The chunk is not replaced, since one of its segments is missing. It can be compressed again later.
+      if (!pending_chunk.failed.exchange(true)) _abort_compression(pending_chunk.chunk_id);
+      throw;
+    }
+
+    if (--pending_chunk.remaining_segment_count > 0) return;
+
+    auto& statistics = pending_chunk.statistics;
+    statistics.chunk_id = pending_chunk.chunk_id;
+    for (ColumnID segment_id{0}; segment_id < pending_chunk.segments.size(); ++segment_id) {
+      statistics.encoding_duration += pending_chunk.encoding_durations[segment_id];
+      statistics.memory_usage_before += pending_chunk.segments[segment_id]->estimate_memory_usage();
+      statistics.memory_usage_after += pending_chunk.encoded_segments[segment_id]->estimate_memory_usage();
     }
+    _finish_compression(pending_chunk.chunk_id, pending_chunk.encoded_segments, pending_chunk.zone_maps);
+    pending_chunk.segments.clear();
+    pending_chunk.encoded_segments.clear();
+  });
 
-    _compressed_chunks[chunk_id] = true;
+  // Compressed chunks are immutable, so subsequent appends need a new chunk
+  if (!pending_chunks.empty() && pending_chunks.back().chunk_id + 1 == chunk_count()) {
+    create_new_chunk();
+  }
+
+  std::vector<ChunkCompressionStatistics> statistics;
+  for (const auto& pending_chunk : pending_chunks) {
+    statistics.emplace_back(pending_chunk.statistics);
+  }
+  return statistics;
+}
+
+bool Table::_begin_compression(ChunkID chunk_id, std::vector<std::shared_ptr<BaseSegment>>& segments,
+                               std::vector<std::shared_ptr<const BaseZoneMap>>& zone_maps) {
+  auto guard = std::lock_guard{_compression_mutex};
+  if (_compressed_chunks[chunk_id]) {
+    return false;
   }
 
-  Chunk compressed_chunk;
+  _compressed_chunks[chunk_id] = true;
+
+  // _seal_chunk might set the zone maps concurrently, so the chunk is only accessed while holding the mutex
   const auto& chunk = get_chunk(chunk_id);
   for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
-    const auto segment = chunk.get_segment(column_id);
-    const auto& column_type = _column_types[column_id];
-    const auto compressed_segment = make_shared_by_data_type<BaseSegment, DictionarySegment>(column_type, segment);
-    compressed_chunk.add_segment(std::move(compressed_segment));
+    segments.emplace_back(chunk.get_segment(column_id));
+    if (chunk.get_zone_map(column_id)) zone_maps.emplace_back(chunk.get_zone_map(column_id));
+  }
+
+  // Zone maps of empty segments are missing, so they are rebuilt if any is missing
+  if (zone_maps.size() != segments.size()) {
+    zone_maps.clear();
+  }
+  return true;
+}
+
+bool Table::_is_compressed(ChunkID chunk_id) {
+  auto guard = std::lock_guard{_compression_mutex};
+  return _compressed_chunks[chunk_id];
+}
+
+void Table::_abort_compression(ChunkID chunk_id) {
+  auto guard = std::lock_guard{_compression_mutex};
+  _compressed_chunks[chunk_id] = false;
+}
+
+void Table::_finish_compression(ChunkID chunk_id, const std::vector<std::shared_ptr<BaseSegment>>& segments,
+                                const std::vector<std::shared_ptr<const BaseZoneMap>>& zone_maps) {
+  // Queries may be reading the chunk, so its segments are swapped atomically instead of replacing the chunk
+  auto guard = std::lock_guard{_compression_mutex};
+  get_chunk(chunk_id).replace_segments(segments, zone_maps);
+}
+
+void Table::enable_auto_compression(const size_t worker_count, const EncodingType encoding_type) {
+  Assert(!_compression_service, "Auto compression is enabled already");
+  _compression_service = std::make_unique<CompressionService>(*this, worker_count, encoding_type);
+
+  // All chunks but the last one are full, which is full as well if the next chunk was not created yet. compress_chunk
+  // skips those that are compressed already.
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count(); ++chunk_id) {
+    if (chunk_id + 1 < chunk_count() || _chunk_slot(chunk_id).written_row_count == _chunk_size) {
+      _compression_service->enqueue(chunk_id);
+    }
   }
+}
 
-  _chunks[chunk_id] = std::move(compressed_chunk);
+void Table::wait_for_auto_compression() {
+  Assert(_compression_service, "Auto compression is not enabled");
+  _compression_service->wait_until_idle();
+}
+
+void Table::disable_auto_compression() {
+  Assert(_compression_service, "Auto compression is not enabled");
+  // The service is destroyed even if compressing a chunk failed
+  auto compression_service = std::move(_compression_service);
+  compression_service->wait_until_idle();
+}
+
+std::vector<std::shared_ptr<const BaseZoneMap>> Table::_build_zone_maps(
+    const std::vector<std::shared_ptr<BaseSegment>>& segments) const {
+  std::vector<std::shared_ptr<const BaseZoneMap>> zone_maps;
+  for (ColumnID column_id{0}; column_id < segments.size(); ++column_id) {
+    zone_maps.emplace_back(_build_zone_map(column_id, segments[column_id]));
+  }
+  return zone_maps;
+}
+
+std::shared_ptr<const BaseZoneMap> Table::_build_zone_map(ColumnID column_id,
+                                                          const std::shared_ptr<BaseSegment>& segment) const {
+  // Empty segments have no minimum or maximum. Their scan is cheap anyway.
+  if (segment->size() == 0) {
+    return nullptr;
+  }
+  return make_shared_by_data_type<BaseZoneMap, ZoneMap>(_column_types[column_id], segment);
 }
 
 }  // namespace opossum
@@ -1,32 +1,59 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <limits>
 #include <map>
 #include <memory>
+#include <memory_resource>  // NOLINT(build/include_order)
 #include <mutex>
+#include <shared_mutex>  // NOLINT(build/include_order)
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "base_segment.hpp"
 #include "chunk.hpp"
+#include "encoding_type.hpp"
 
+#include "string_heap.hpp"
 #include "type_cast.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
+#include "value_segment.hpp"
 
 namespace opossum {
 
+class CompressionService;
 class TableStatistics;
 
+// Reports the compression of a single chunk, see Table::compress
+struct ChunkCompressionStatistics {
+  ChunkID chunk_id;
+  // the time spent encoding the segments of the chunk, summed up across all threads. This includes times in which the
+  // threads were preempted, e.g., when there are more threads than cores.
+  std::chrono::nanoseconds encoding_duration;
+  // the memory used by the segments before and after the compression, see BaseSegment::estimate_memory_usage
+  size_t memory_usage_before;
+  size_t memory_usage_after;
+};
+
 // A table is partitioned horizontally into a number of chunks
 class Table : private Noncopyable {
  public:
   // creates a table
   // the parameter specifies the maximum chunk size, i.e., partition size
-  // default is the maximum chunk size minus 1. A table holds always at least one chunk
+  // default is the maximum chunk size minus 1, which is also used for a chunk size of 0. A table holds always at least
+  // one chunk
   explicit Table(const uint32_t chunk_size = std::numeric_limits<ChunkOffset>::max() - 1);
 
+  // stops the auto compression, if enabled
+  ~Table();
+
   // we need to explicitly set the move constructor to default when
   // we overwrite the copy constructor
   Table(Table&&) = default;
@@ -37,17 +64,24 @@ class Table : private Noncopyable {
 
   // Returns the number of rows.
   // This number includes invalidated (deleted) rows.
+  // Rows being appended concurrently are counted once they are written.
   // Use approx_valid_row_count() for an approximate count of valid rows instead.
   uint64_t row_count() const;
 
   // returns the number of chunks (cannot exceed ChunkID (uint32_t))
   ChunkID chunk_count() const;
 
-  // returns the chunk with the given id
+  // Returns the chunk with the given id. Chunks do not move when chunks are added, so this and chunk_count() can be
+  // called while rows are appended. The segments of a chunk, however, can only be read while no rows are written to
+  // it, i.e., once it is full and has zone maps, or once all appends returned. Full chunks can be read while they are
+  // compressed, since the compression swaps their segments atomically, see Chunk::replace_segments.
   Chunk& get_chunk(ChunkID chunk_id);
   const Chunk& get_chunk(ChunkID chunk_id) const;
 
-  // Adds a chunk to the table. If the first chunk is empty, it is replaced.
+  // Adds a chunk to the table. If the last chunk is empty, it is replaced. Chunks that consist of encoded segments
+  // only are not compressed again by compress_chunk, and rows appended afterwards go to a new chunk. A full chunk gets
+  // zone maps and is handed to the auto compression like a chunk filled by append. This must not be called while rows
+  // are appended or the table is read, since an empty last chunk is replaced.
   void emplace_chunk(Chunk&& chunk);
 
   // Returns a list of all column names.
@@ -67,6 +101,10 @@ class Table : private Noncopyable {
   // return the maximum chunk size (cannot exceed ChunkOffset (uint32_t))
   uint32_t chunk_size() const;
 
+  // Returns the number of bytes used by the table, i.e., by all of its chunks, see Chunk::estimate_memory_usage.
+  // Tables referenced by ReferenceSegments are not included. Must not be called while rows are appended.
+  size_t estimate_memory_usage() const;
+
   // adds column definition without creating the actual columns
   // this is helpful when, e.g., an operator first creates the structure of the table
   // and then adds chunk by chunk
@@ -77,25 +115,180 @@ class Table : private Noncopyable {
   // with default values
   void add_column(const std::string& name, const std::string& type);
 
-  // inserts a row at the end of the table
-  // note this is slow and not thread-safe and should be used for testing purposes only
+  // Inserts a row at the end of the table, like append_rows. Once a chunk is full, zone maps are built for it, it is
+  // handed to the auto compression, if enabled, and a new chunk is created. Use append_rows to append many rows at
+  // once, which converts and reserves them together.
   void append(std::vector<AllTypeVariant> values);
 
+  // Inserts rows at the end of the table. This can be called by multiple threads concurrently. Each call converts its
+  // values into the column types first, then reserves a range of rows in the mutable chunk, and copies its values into
+  // the range. Writers do not wait for each other while copying, since their ranges are disjoint and the memory for
+  // them is allocated when they are reserved, see _reserve_rows. Thus, passing many rows at once lets the throughput
+  // scale with the number of writing threads. If the values do not match the columns, or if memory for the rows
+  // cannot be allocated, nothing is inserted. The mutable chunk must not be compressed while rows are appended.
+  void append_rows(const std::vector<std::vector<AllTypeVariant>>& rows);
+
+  // Inserts rows at the end of the table, given as one vector of values per column. The vectors must have the same
+  // length and match the types of the columns, e.g., a std::vector<int32_t> for an int column. Columns may also be
+  // passed as the ValueVector used by the segments, i.e., a std::pmr::vector or a StringHeap. Unlike append_rows, the
+  // values are not converted from AllTypeVariants: they are copied into the segments with a single insert per column
+  // and chunk. ValueVectors are moved into the segments instead if they fill an empty chunk of their own. Pass them as
+  // rvalues to avoid copying them beforehand. Like append_rows, this is thread-safe.
+  template <typename... Columns>
+  void append_columns(Columns&&... columns) {
+    std::vector<std::shared_ptr<BaseSegment>> segments;
+    (segments.emplace_back(_make_value_segment(std::forward<Columns>(columns))), ...);
+    _append_segments(segments);
+  }
+
   // creates a new chunk and appends it
   void create_new_chunk();
 
-  // compresses a ValueSegment into a DictionarySegment
-  void compress_chunk(ChunkID chunk_id);
+  // compresses the ValueSegments of a chunk with the given encoding, e.g., into DictionarySegments
+  // different chunks can be compressed in parallel by calling this from multiple threads
+  // The compressed chunk keeps the zone maps of the chunk, or gets new ones if it had none yet.
+  void compress_chunk(ChunkID chunk_id, EncodingType encoding_type = EncodingType::Dictionary);
+
+  // same as compress_chunk(ChunkID, EncodingType), but encodes each column with the encoding given for it
+  void compress_chunk(ChunkID chunk_id, const ChunkEncodingSpec& encoding_spec);
+
+  // Compresses all chunks that are not compressed yet, using the given number of threads. The segments of all chunks
+  // are encoded in parallel, so that even tables with fewer chunks than threads keep all threads busy. Each chunk is
+  // replaced as soon as all of its segments are encoded. If the last chunk is compressed, a new one is created for
+  // subsequent appends. Returns the statistics of all compressed chunks, ordered by chunk id.
+  std::vector<ChunkCompressionStatistics> compress(
+      const ChunkEncodingSpec& encoding_spec, size_t thread_count = std::max(1u, std::thread::hardware_concurrency()));
+
+  // Starts worker threads that compress each chunk with the given encoding as soon as append() filled it, so that
+  // inserting threads do not have to. Chunks that are full already are compressed as well. Like with compress_chunk,
+  // the encoded segments replace the original ones, which stay valid for readers that obtained them before.
+  void enable_auto_compression(size_t worker_count = 1, EncodingType encoding_type = EncodingType::Dictionary);
+
+  // Blocks until all full chunks are compressed. Rethrows the first exception that occurred while compressing.
+  void wait_for_auto_compression();
+
+  // Compresses the remaining full chunks and stops the worker threads
+  void disable_auto_compression();
 
  protected:
+  // wraps the values of a column passed to append_columns in a ValueSegment
+  template <typename T>
+  static std::shared_ptr<BaseSegment> _make_value_segment(std::vector<T> values) {
+    if constexpr (std::is_same_v<T, std::string>) {
+      auto bytes = size_t{0};
+      for (const auto& value : values) bytes += value.size();
+      StringHeap heap;
+      heap.reserve(values.size(), bytes);
+      for (const auto& value : values) heap.emplace_back(value);
+      return std::make_shared<ValueSegment<std::string>>(std::move(heap));
+    } else {
+      return std::make_shared<ValueSegment<T>>(ValueVector<T>(values.begin(), values.end()));
+    }
+  }
+
+  template <typename T>
+  static std::shared_ptr<BaseSegment> _make_value_segment(std::pmr::vector<T> values) {
+    return std::make_shared<ValueSegment<T>>(std::move(values));
+  }
+
+  static std::shared_ptr<BaseSegment> _make_value_segment(StringHeap values) {
+    return std::make_shared<ValueSegment<std::string>>(std::move(values));
+  }
+
+  // Appends the values of the given ValueSegments, one per column, which may be moved out of them. Rows are reserved
+  // and written in ranges that do not exceed the mutable chunk, see append_rows.
+  void _append_segments(const std::vector<std::shared_ptr<BaseSegment>>& segments);
+
+  // offsets [begin, end) of a chunk that were reserved for appending rows
+  struct RowRange {
+    ChunkID chunk_id;
+    ChunkOffset begin;
+    ChunkOffset end;
+    // true if the values were moved into the chunk when the rows were reserved
+    bool written;
+  };
+
+  // Reserves rows for the values of the given ValueSegments starting at first_row, as many as fit into the mutable
+  // chunk, and adds placeholders for them to its segments. The rows are written by _write_rows. If they fill the empty
+  // mutable chunk, the values are moved into it instead. If memory cannot be allocated for the rows, nothing is
+  // reserved, so that subsequent writers are not affected.
+  RowRange _reserve_rows(const std::vector<std::shared_ptr<BaseSegment>>& segments, size_t first_row);
+
+  // Overwrites the placeholders of the given range with the rows starting at first_row of the given ValueSegments.
+  // This does not allocate memory and cannot fail.
+  void _write_rows(const RowRange& rows, const std::vector<std::shared_ptr<BaseSegment>>& segments,
+                   size_t first_row) noexcept;
+
+  // Counts written rows for row_count(). The writer that completes a chunk builds its zone maps and hands it to the
+  // auto compression, and the one that reserved its last rows creates the next mutable chunk.
+  void _finish_rows(const RowRange& rows);
+
+  // builds the zone maps of a full chunk unless it has some already, and hands it to the auto compression, if enabled
+  void _seal_chunk(ChunkID chunk_id);
+
+  // adds a chunk with empty ValueSegments and makes it the mutable chunk. Requires _append_mutex to be held.
+  void _create_mutable_chunk();
+
+  // adds a chunk to the chunk slots, which is visible to chunk_count() afterwards
+  void _add_chunk(Chunk&& chunk, bool is_compressed);
+
+  // A chunk and the number of its rows that are written, see _finish_rows
+  struct ChunkSlot {
+    Chunk chunk;
+    std::atomic<ChunkOffset> written_row_count{0};
+  };
+
+  // returns the slot of a chunk
+  ChunkSlot& _chunk_slot(ChunkID chunk_id) const;
+
+  // Marks a chunk as compressed and returns its segments and zone maps. Returns false if the chunk is compressed or
+  // being compressed already. The zone maps are empty if none were built for the chunk yet.
+  bool _begin_compression(ChunkID chunk_id, std::vector<std::shared_ptr<BaseSegment>>& segments,
+                          std::vector<std::shared_ptr<const BaseZoneMap>>& zone_maps);
+
+  // returns whether a chunk is compressed or being compressed
+  bool _is_compressed(ChunkID chunk_id);
+
+  // marks a chunk as not compressed again after its segments could not be encoded, so that it can be compressed later
+  void _abort_compression(ChunkID chunk_id);
+
+  // replaces the segments and zone maps of a chunk with the given ones, see Chunk::replace_segments
+  void _finish_compression(ChunkID chunk_id, const std::vector<std::shared_ptr<BaseSegment>>& segments,
+                           const std::vector<std::shared_ptr<const BaseZoneMap>>& zone_maps);
+
+  // builds a zone map for each of the given segments, see ZoneMap
+  std::vector<std::shared_ptr<const BaseZoneMap>> _build_zone_maps(
+      const std::vector<std::shared_ptr<BaseSegment>>& segments) const;
+
+  // builds the zone map of a single segment, or returns nullptr if the segment is empty
+  std::shared_ptr<const BaseZoneMap> _build_zone_map(ColumnID column_id,
+                                                     const std::shared_ptr<BaseSegment>& segment) const;
+
   uint32_t _chunk_size;
-  std::vector<Chunk> _chunks;
+  // Chunks are stored in blocks that never move, so that chunks can be accessed while new chunks are added. Block b
+  // holds the 2^b chunks starting at id 2^b - 1. The blocks are allocated when their first chunk is added, and
+  // _chunk_count is only increased once a chunk is in place.
+  std::array<std::unique_ptr<ChunkSlot[]>, 32> _chunk_blocks;
+  std::atomic<uint32_t> _chunk_count{0};
   std::map<std::string, ColumnID> _name_column_map;
   std::vector<std::string> _column_names;
   std::vector<std::string> _column_types;
   // Bitset to track chunks which are either compressed or currently being compressed.
   std::vector<bool> _compressed_chunks;
-  // Mutex to protect concurrent accesses to _compressed_chunks
+  // Mutex to protect concurrent accesses to _compressed_chunks and to the chunks replaced by compress_chunk
   std::mutex _compression_mutex;
+  // Workers that compress full chunks in the background, nullptr unless enable_auto_compression was called
+  std::unique_ptr<CompressionService> _compression_service;
+
+  // Protects the reservation of rows, i.e., the chunk rows are appended to and the number of rows reserved in it
+  std::mutex _append_mutex;
+  ChunkID _mutable_chunk_id{0};
+  ChunkOffset _reserved_row_count{0};
+  // Writers hold this in shared mode while writing their rows. Allocating more memory for the segments of the mutable
+  // chunk moves their values, so this requires holding it exclusively.
+  std::shared_mutex _storage_mutex;
+
+  // number of written rows, see row_count()
+  std::atomic<uint64_t> _row_count{0};
 };
 }  // namespace opossum
@@ -1,9 +1,11 @@
 #include "value_segment.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -13,11 +15,17 @@
 
 namespace opossum {
 
+template <typename T>
+ValueSegment<T>::ValueSegment(std::pmr::memory_resource* memory_resource) : _values{memory_resource} {}
+
+template <typename T>
+ValueSegment<T>::ValueSegment(ValueVector<T> values) : _values{std::move(values)} {}
+
 template <typename T>
 const AllTypeVariant ValueSegment<T>::operator[](const size_t offset) const {
   PerformanceWarning("operator[] used");
 
-  return values()[offset];
+  return T{values()[offset]};
 }
 
 template <typename T>
@@ -25,13 +33,90 @@ void ValueSegment<T>::append(const AllTypeVariant& val) {
   _values.emplace_back(type_cast<T>(val));
 }
 
+template <typename T>
+void ValueSegment<T>::append_values(const ValueVector<T>& values, const size_t begin, const size_t end) {
+  DebugAssert(begin <= end && end <= values.size(), "Range out of bounds");
+  if constexpr (std::is_same_v<T, std::string>) {
+    _values.append(values, begin, end);
+  } else {
+    _values.insert(_values.end(), values.begin() + begin, values.begin() + end);
+  }
+}
+
+template <typename T>
+void ValueSegment<T>::append_values(ValueVector<T>&& values) {
+  if (_values.empty()) {
+    _values = std::move(values);
+  } else {
+    append_values(values, 0, values.size());
+  }
+}
+
+template <typename T>
+bool ValueSegment<T>::has_capacity_for(const size_t count, const size_t bytes) const {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return _values.size() + count <= _values.capacity() && _values.byte_count() + bytes <= _values.byte_capacity();
+  } else {
+    return _values.size() + count <= _values.capacity();
+  }
+}
+
+template <typename T>
+void ValueSegment<T>::reserve(const size_t count, const size_t bytes) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    _values.reserve(count, bytes);
+  } else {
+    _values.reserve(count);
+  }
+}
+
+template <typename T>
+void ValueSegment<T>::append_placeholders(const size_t count, const size_t bytes) {
+  DebugAssert(has_capacity_for(count, bytes), "Placeholders would move the values of the segment");
+  if constexpr (std::is_same_v<T, std::string>) {
+    _values.append_placeholders(count, bytes);
+  } else {
+    _values.resize(_values.size() + count);
+  }
+}
+
+template <typename T>
+void ValueSegment<T>::write_values(const size_t offset, const ValueVector<T>& values, const size_t begin,
+                                   const size_t end) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    _values.write(offset, values, begin, end);
+  } else {
+    DebugAssert(begin <= end && end <= values.size(), "Range out of bounds");
+    std::copy(values.begin() + begin, values.begin() + end, _values.begin() + offset);
+  }
+}
+
+template <typename T>
+ValueVector<T> ValueSegment<T>::release_values() {
+  return std::exchange(_values, ValueVector<T>{_values.get_allocator()});
+}
+
+template <typename T>
+std::pmr::memory_resource* ValueSegment<T>::memory_resource() const {
+  return _values.get_allocator().resource();
+}
+
 template <typename T>
 size_t ValueSegment<T>::size() const {
   return values().size();
 }
 
 template <typename T>
-const std::vector<T>& ValueSegment<T>::values() const {
+size_t ValueSegment<T>::estimate_memory_usage() const {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return sizeof(*this) + _values.estimate_memory_usage();
+  } else {
+    return sizeof(*this) + _values.capacity() * sizeof(T);
+  }
+}
+
+template <typename T>
+const ValueVector<T>& ValueSegment<T>::values() const {
   return _values;
 }
 
@@ -1,34 +1,79 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>  // NOLINT(build/include_order)
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base_segment.hpp"
+#include "string_heap.hpp"
 
 namespace opossum {
 
-// ValueSegment is a segment type that stores all its values in a vector
+// ValueSegment is a segment type that stores all its values in a vector, or a StringHeap for strings
 template <typename T>
 class ValueSegment : public BaseSegment {
  public:
+  ValueSegment() = default;
+
+  // Creates an empty segment that allocates its values from the given memory resource, which must outlive the segment.
+  // Values moved into the segment keep the memory resource they were allocated from.
+  explicit ValueSegment(std::pmr::memory_resource* memory_resource);
+
+  // creates a segment that holds the given values
+  explicit ValueSegment(ValueVector<T> values);
+
   // return the value at a certain position. If you want to write efficient operators, back off!
   const AllTypeVariant operator[](size_t offset) const override;
 
   // add a value to the end
   void append(const AllTypeVariant& val) override;
 
+  // add the values at positions [begin, end) of the given vector to the end. Unlike append(), this does not convert
+  // each value from an AllTypeVariant.
+  void append_values(const ValueVector<T>& values, size_t begin, size_t end);
+
+  // same as append_values(values, 0, values.size()), but takes over the values without copying them if the segment is
+  // empty
+  void append_values(ValueVector<T>&& values);
+
+  // Returns whether `count` more values fit into the memory allocated for the segment. For strings, `bytes` is their
+  // total length.
+  bool has_capacity_for(size_t count, size_t bytes = 0) const;
+
+  // allocates memory for a total of `count` values, and for strings with a total length of `bytes`
+  void reserve(size_t count, size_t bytes = 0);
+
+  // Adds `count` values, which are overwritten later by write_values. For strings, `bytes` is their total length. The
+  // values must fit into the allocated memory, see has_capacity_for, so that the values already in the segment do not
+  // move. Thus, the placeholders added by one thread can be written while another thread adds more.
+  void append_placeholders(size_t count, size_t bytes = 0);
+
+  // Overwrites the placeholders starting at `offset` with the values at positions [begin, end) of the given vector.
+  // The placeholders must have been added by a single call of append_placeholders. Different ranges of placeholders can
+  // be written by multiple threads concurrently.
+  void write_values(size_t offset, const ValueVector<T>& values, size_t begin, size_t end);
+
+  // removes all values from the segment and returns them. The segment keeps allocating from its memory resource.
+  ValueVector<T> release_values();
+
+  // returns the memory resource the values are allocated from
+  std::pmr::memory_resource* memory_resource() const;
+
   // return the number of entries
   size_t size() const override;
 
+  size_t estimate_memory_usage() const override;
+
   // Return all values. This is the preferred method to check a value at a certain index. Usually you need to
   // access more than a single value anyway.
   // e.g. const auto& values = value_segment.values(); and then: values[i]; in your loop.
-  const std::vector<T>& values() const;
+  // For strings, values[i] is a std::string_view into the segment.
+  const ValueVector<T>& values() const;
 
  protected:
-  std::vector<T> _values;
+  ValueVector<T> _values;
 };
 
 }  // namespace opossum
@@ -0,0 +1,111 @@
+#include "zone_map.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "dictionary_segment.hpp"
+#include "resolve_type.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "utils/performance_warning.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+template <typename T>
+ZoneMap<T>::ZoneMap(const std::shared_ptr<BaseSegment>& base_segment) {
+  DebugAssert(base_segment->size() > 0, "Cannot build a zone map for an empty segment");
+
+  if (const auto value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment); value_segment != nullptr) {
+    const auto& values = value_segment->values();
+    const auto minmax = std::minmax_element(values.begin(), values.end());
+    _min = T{*minmax.first};
+    _max = T{*minmax.second};
+  } else if (const auto dictionary_segment = std::dynamic_pointer_cast<DictionarySegment<T>>(base_segment);
+             dictionary_segment != nullptr) {
+    // The dictionary is sorted
+    _min = dictionary_segment->value_by_value_id(ValueID{0});
+    _max = dictionary_segment->value_by_value_id(
+        ValueID{static_cast<uint32_t>(dictionary_segment->unique_values_count() - 1)});
+  } else {
+    PerformanceWarning("Building a zone map for a segment that is neither a ValueSegment nor a DictionarySegment");
+    _min = _max = type_cast<T>((*base_segment)[0]);
+    for (size_t position{1}; position < base_segment->size(); ++position) {
+      const auto value = type_cast<T>((*base_segment)[position]);
+      _min = std::min(_min, value);
+      _max = std::max(_max, value);
+    }
+  }
+}
+
+template <typename T>
+ZoneMap<T>::ZoneMap(const T& min, const T& max) : _min{min}, _max{max} {
+  DebugAssert(!(max < min), "The minimum of a zone map cannot be larger than its maximum");
+}
+
+template <typename T>
+const T& ZoneMap<T>::min() const {
+  return _min;
+}
+
+template <typename T>
+const T& ZoneMap<T>::max() const {
+  return _max;
+}
+
+template <typename T>
+size_t ZoneMap<T>::estimate_memory_usage() const {
+  auto bytes = sizeof(*this);
+  if constexpr (std::is_same_v<T, std::string>) {
+    // Short strings are stored within std::string itself, longer ones are allocated on the heap
+    for (const auto* value : {&_min, &_max}) {
+      if (value->capacity() > std::string{}.capacity()) bytes += value->capacity() + 1;
+    }
+  }
+  return bytes;
+}
+
+template <typename T>
+bool ZoneMap<T>::can_match(const ScanType scan_type, const T& search_value) const {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return !(search_value < _min) && !(_max < search_value);
+    case ScanType::OpNotEquals:
+      return !(_min == search_value && _max == search_value);
+    case ScanType::OpLessThan:
+      return _min < search_value;
+    case ScanType::OpLessThanEquals:
+      return !(search_value < _min);
+    case ScanType::OpGreaterThan:
+      return search_value < _max;
+    case ScanType::OpGreaterThanEquals:
+      return !(_max < search_value);
+  }
+  Fail("Invalid scan type");
+  return true;
+}
+
+template <typename T>
+bool ZoneMap<T>::matches_all(const ScanType scan_type, const T& search_value) const {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return _min == search_value && _max == search_value;
+    case ScanType::OpNotEquals:
+      return search_value < _min || _max < search_value;
+    case ScanType::OpLessThan:
+      return _max < search_value;
+    case ScanType::OpLessThanEquals:
+      return !(search_value < _max);
+    case ScanType::OpGreaterThan:
+      return search_value < _min;
+    case ScanType::OpGreaterThanEquals:
+      return !(_min < search_value);
+  }
+  Fail("Invalid scan type");
+  return false;
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(ZoneMap);
+
+}  // namespace opossum
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "base_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// BaseZoneMap is the abstract super class of ZoneMap, so that chunks can store zone maps of all types
+class BaseZoneMap : private Noncopyable {
+ public:
+  virtual ~BaseZoneMap() = default;
+
+  // returns the number of bytes used by the zone map, including the memory allocated on the heap
+  virtual size_t estimate_memory_usage() const = 0;
+};
+
+// A ZoneMap holds the smallest and the largest value of a segment. Before looking at the data of a segment, a scan can
+// use it to find out whether no row of the segment can match a predicate, or whether all rows match it.
+//
+// Zone maps are built for segments that no longer change, i.e., when a chunk is full or compressed, see Table.
+template <typename T>
+class ZoneMap : public BaseZoneMap {
+ public:
+  // Creates a ZoneMap from a segment of any type. The segment must not be empty.
+  explicit ZoneMap(const std::shared_ptr<BaseSegment>& base_segment);
+
+  ZoneMap(const T& min, const T& max);
+
+  // returns the smallest value of the segment
+  const T& min() const;
+
+  // returns the largest value of the segment
+  const T& max() const;
+
+  // returns false if no value of the segment can satisfy `value <scan_type> search_value`
+  bool can_match(ScanType scan_type, const T& search_value) const;
+
+  // returns true if all values of the segment satisfy `value <scan_type> search_value`
+  bool matches_all(ScanType scan_type, const T& search_value) const;
+
+  size_t estimate_memory_usage() const override;
+
+ protected:
+  T _min{};
+  T _max{};
+};
+
+}  // namespace opossum
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <iostream>
 #include <limits>
+#include <memory_resource>  // NOLINT(build/include_order)
 #include <string>
 #include <tuple>
 #include <vector>
@@ -53,7 +54,8 @@ struct RowID {
 
 enum class ScanType { OpEquals, OpNotEquals, OpLessThan, OpLessThanEquals, OpGreaterThan, OpGreaterThanEquals };
 
-using PosList = std::vector<RowID>;
+// PosLists may be allocated from a memory resource, e.g., the QueryArena of the operators of a query
+using PosList = std::pmr::vector<RowID>;
 
 // Prevents unnecessary, potentially expensive, copies by deleting copy constructor and copy assignment operator.
 class Noncopyable {
@@ -0,0 +1,435 @@
+#include "binary_table.hpp"
+
+#include <array>
+#include <cstring>
+#include <filesystem>  // NOLINT(build/include_order)
+#include <fstream>
+#include <memory>
+#include <memory_resource>  // NOLINT(build/include_order)
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/bit_packed_attribute_vector.hpp"
+#include "storage/bloom_filter.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/fitted_attribute_vector.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/front_coded_dictionary.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/zone_map.hpp"
+#include "utils/assert.hpp"
+#include "utils/mapped_file.hpp"
+
+namespace opossum {
+
+namespace {
+
+// A file consists of a header, the column definitions, and the chunks. Each chunk stores its segments one after the
+// other, followed by its zone maps. All numbers are stored in the byte order of the machine.
+constexpr auto MAGIC = std::array<char, 8>{'O', 'P', 'O', 'S', 'S', 'U', 'M', 'T'};
+// Version 2 changed the hash of the membership filters of dictionaries, see BloomFilter
+constexpr auto FORMAT_VERSION = uint32_t{2};
+
+// Arrays start at multiples of this offset. Mapped files are page-aligned, so that arrays referenced in a mapped file
+// are aligned like in memory.
+constexpr auto ARRAY_ALIGNMENT = size_t{64};
+
+enum class SegmentKind : uint8_t { Value, Dictionary, FrontCodedDictionary, RunLength, FrameOfReference };
+enum class AttributeVectorKind : uint8_t { Fitted, BitPacked };
+
+class BinaryWriter {
+ public:
+  explicit BinaryWriter(const std::string& file_name) : _stream{file_name, std::ios::binary | std::ios::trunc} {
+    Assert(_stream.is_open(), "write_binary_table: Could not open file " + file_name);
+  }
+
+  template <typename T>
+  void write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written directly");
+    static_assert(!std::is_same_v<T, bool>, "Use write_bool, which does not depend on the representation of bool");
+    _write_bytes(&value, sizeof(T));
+  }
+
+  void write_bool(const bool value) { write(uint8_t{value}); }
+
+  void write_string(const std::string_view string) {
+    write(uint64_t{string.size()});
+    _write_bytes(string.data(), string.size());
+  }
+
+  // writes a value of a column, which may be a string
+  template <typename T>
+  void write_value(const T& value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+      write_string(value);
+    } else {
+      write(value);
+    }
+  }
+
+  // writes the number of elements, followed by the elements starting at an aligned offset
+  template <typename T>
+  void write_array(const T* data, const size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only arrays of trivially copyable values can be written");
+    write(uint64_t{count});
+    static constexpr auto zeros = std::array<char, ARRAY_ALIGNMENT>{};
+    _write_bytes(zeros.data(), (ARRAY_ALIGNMENT - _offset % ARRAY_ALIGNMENT) % ARRAY_ALIGNMENT);
+    _write_bytes(data, count * sizeof(T));
+  }
+
+  template <typename Container>
+  void write_array(const Container& container) {
+    write_array(container.data(), container.size());
+  }
+
+  void finish() {
+    _stream.flush();
+    Assert(_stream.good(), "write_binary_table: Could not write file");
+  }
+
+ protected:
+  void _write_bytes(const void* data, const size_t size) {
+    _stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    _offset += size;
+  }
+
+  std::ofstream _stream;
+  size_t _offset{0};
+};
+
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::shared_ptr<const MappedFile> file) : _file{std::move(file)} {}
+
+  template <typename T>
+  T read() {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read directly");
+    static_assert(!std::is_same_v<T, bool>, "Use read_bool, since a byte of a corrupt file may not be a valid bool");
+    T value;
+    std::memcpy(&value, _take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  bool read_bool() {
+    const auto value = read<uint8_t>();
+    Assert(value <= 1, "read_binary_table: Invalid boolean value");
+    return value == 1;
+  }
+
+  std::string read_string() {
+    const auto size = read<uint64_t>();
+    return std::string{_take(size), size};
+  }
+
+  template <typename T>
+  T read_value() {
+    if constexpr (std::is_same_v<T, std::string>) {
+      return read_string();
+    } else {
+      return read<T>();
+    }
+  }
+
+  // returns the address of an array written by BinaryWriter::write_array in the mapped file and its number of elements
+  template <typename T>
+  std::pair<const T*, size_t> read_array() {
+    const auto count = read<uint64_t>();
+    _take((ARRAY_ALIGNMENT - _offset % ARRAY_ALIGNMENT) % ARRAY_ALIGNMENT);
+    return {reinterpret_cast<const T*>(_take(count * sizeof(T))), count};
+  }
+
+  // copies an array into a container that is constructible from a range, e.g., a std::vector
+  template <typename Container>
+  Container read_container() {
+    const auto array = read_array<typename Container::value_type>();
+    return Container(array.first, array.first + array.second);
+  }
+
+  const std::shared_ptr<const MappedFile>& file() const { return _file; }
+
+ protected:
+  const char* _take(const size_t bytes) {
+    Assert(bytes <= _file->size() - _offset, "read_binary_table: File is truncated");
+    const auto* const data = _file->data() + _offset;
+    _offset += bytes;
+    return data;
+  }
+
+  const std::shared_ptr<const MappedFile> _file;
+  size_t _offset{0};
+};
+
+template <typename T>
+void write_values(BinaryWriter& writer, const ValueVector<T>& values) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    writer.write_array(values.bytes());
+    writer.write_array(values.offsets());
+  } else {
+    writer.write_array(values);
+  }
+}
+
+template <typename T>
+ValueVector<T> read_values(BinaryReader& reader) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    auto bytes = reader.read_container<std::pmr::vector<char>>();
+    return StringHeap{std::move(bytes), reader.read_container<std::pmr::vector<size_t>>()};
+  } else {
+    return reader.read_container<ValueVector<T>>();
+  }
+}
+
+void write_attribute_vector(BinaryWriter& writer, const BaseAttributeVector& attribute_vector) {
+  if (const auto* bit_packed_vector = dynamic_cast<const BitPackedAttributeVector*>(&attribute_vector)) {
+    writer.write(AttributeVectorKind::BitPacked);
+    writer.write(uint64_t{bit_packed_vector->size()});
+    writer.write(bit_packed_vector->bit_width());
+    writer.write_array(bit_packed_vector->words(),
+                       BitPackedAttributeVector::word_count(bit_packed_vector->size(), bit_packed_vector->bit_width()));
+    return;
+  }
+
+  writer.write(AttributeVectorKind::Fitted);
+  writer.write(attribute_vector.width());
+  if (const auto* uint8_vector = dynamic_cast<const FittedAttributeVector<uint8_t>*>(&attribute_vector)) {
+    writer.write_array(uint8_vector->data(), uint8_vector->size());
+  } else if (const auto* uint16_vector = dynamic_cast<const FittedAttributeVector<uint16_t>*>(&attribute_vector)) {
+    writer.write_array(uint16_vector->data(), uint16_vector->size());
+  } else if (const auto* uint32_vector = dynamic_cast<const FittedAttributeVector<uint32_t>*>(&attribute_vector)) {
+    writer.write_array(uint32_vector->data(), uint32_vector->size());
+  } else {
+    Fail("write_binary_table: Unknown attribute vector type");
+  }
+}
+
+std::shared_ptr<BitPackedAttributeVector> read_bit_packed_attribute_vector(BinaryReader& reader) {
+  const auto size = static_cast<size_t>(reader.read<uint64_t>());
+  const auto bit_width = reader.read<uint8_t>();
+  const auto words = reader.read_array<uint64_t>();
+  Assert(bit_width >= 1 && bit_width <= 32 && words.second == BitPackedAttributeVector::word_count(size, bit_width),
+         "read_binary_table: Invalid bit-packed attribute vector");
+  return std::make_shared<BitPackedAttributeVector>(size, bit_width, words.first, reader.file());
+}
+
+std::shared_ptr<BaseAttributeVector> read_attribute_vector(BinaryReader& reader) {
+  const auto kind = reader.read<AttributeVectorKind>();
+  if (kind == AttributeVectorKind::BitPacked) return read_bit_packed_attribute_vector(reader);
+  Assert(kind == AttributeVectorKind::Fitted, "read_binary_table: Unknown attribute vector type");
+
+  const auto reference_array = [&](auto type) -> std::shared_ptr<BaseAttributeVector> {
+    using FittedType = decltype(type);
+    const auto array = reader.read_array<FittedType>();
+    return std::make_shared<FittedAttributeVector<FittedType>>(array.first, array.second, reader.file());
+  };
+  switch (reader.read<AttributeVectorWidth>()) {
+    case 1:
+      return reference_array(uint8_t{});
+    case 2:
+      return reference_array(uint16_t{});
+    case 4:
+      return reference_array(uint32_t{});
+  }
+  Fail("read_binary_table: Invalid attribute vector width");
+  return nullptr;
+}
+
+template <typename T>
+void write_segment(BinaryWriter& writer, const BaseSegment& segment) {
+  if (const auto* value_segment = dynamic_cast<const ValueSegment<T>*>(&segment)) {
+    writer.write(SegmentKind::Value);
+    write_values<T>(writer, value_segment->values());
+  } else if (const auto* dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment)) {
+    if (const auto front_coded_dictionary = dictionary_segment->front_coded_dictionary()) {
+      writer.write(SegmentKind::FrontCodedDictionary);
+      writer.write(uint64_t{front_coded_dictionary->size()});
+      writer.write_array(front_coded_dictionary->bytes());
+      writer.write_array(front_coded_dictionary->block_offsets());
+    } else {
+      writer.write(SegmentKind::Dictionary);
+      write_values<T>(writer, *dictionary_segment->dictionary());
+    }
+    write_attribute_vector(writer, *dictionary_segment->attribute_vector());
+
+    const auto membership_filter = dictionary_segment->membership_filter();
+    writer.write_bool(membership_filter != nullptr);
+    if (membership_filter) writer.write_array(membership_filter->words());
+  } else if (const auto* run_length_segment = dynamic_cast<const RunLengthSegment<T>*>(&segment)) {
+    writer.write(SegmentKind::RunLength);
+    const auto& values = run_length_segment->values();
+    if constexpr (std::is_same_v<T, std::string>) {
+      writer.write(uint64_t{values.size()});
+      for (const auto& value : values) writer.write_string(value);
+    } else {
+      writer.write_array(values);
+    }
+    writer.write_array(run_length_segment->end_positions());
+  } else if (const auto* frame_of_reference_segment = dynamic_cast<const FrameOfReferenceSegment<T>*>(&segment)) {
+    writer.write(SegmentKind::FrameOfReference);
+    writer.write_value(frame_of_reference_segment->minimum());
+    write_attribute_vector(writer, *frame_of_reference_segment->offsets());
+  } else {
+    Fail("write_binary_table: Cannot write this type of segment, e.g., a ReferenceSegment");
+  }
+}
+
+template <typename T>
+std::shared_ptr<BaseSegment> read_segment(BinaryReader& reader) {
+  const auto kind = reader.read<SegmentKind>();
+  switch (kind) {
+    case SegmentKind::Value:
+      return std::make_shared<ValueSegment<T>>(read_values<T>(reader));
+
+    case SegmentKind::Dictionary:
+    case SegmentKind::FrontCodedDictionary: {
+      std::shared_ptr<ValueVector<T>> dictionary;
+      std::shared_ptr<FrontCodedDictionary> front_coded_dictionary;
+      if (kind == SegmentKind::FrontCodedDictionary) {
+        if constexpr (std::is_same_v<T, std::string>) {
+          const auto size = static_cast<size_t>(reader.read<uint64_t>());
+          auto bytes = reader.read_container<std::vector<char>>();
+          auto block_offsets = reader.read_container<std::vector<size_t>>();
+          front_coded_dictionary =
+              std::make_shared<FrontCodedDictionary>(std::move(bytes), std::move(block_offsets), size);
+        } else {
+          Fail("read_binary_table: Only string dictionaries can be front coded");
+        }
+      } else {
+        dictionary = std::make_shared<ValueVector<T>>(read_values<T>(reader));
+      }
+      auto attribute_vector = read_attribute_vector(reader);
+
+      std::shared_ptr<const BloomFilter> membership_filter;
+      if (reader.read_bool()) {
+        membership_filter = std::make_shared<BloomFilter>(reader.read_container<std::vector<uint64_t>>());
+      }
+
+      return std::make_shared<DictionarySegment<T>>(std::move(dictionary), std::move(front_coded_dictionary),
+                                                    std::move(attribute_vector), std::move(membership_filter));
+    }
+
+    case SegmentKind::RunLength: {
+      std::vector<T> values;
+      if constexpr (std::is_same_v<T, std::string>) {
+        values.resize(static_cast<size_t>(reader.read<uint64_t>()));
+        for (auto& value : values) value = reader.read_string();
+      } else {
+        values = reader.read_container<std::vector<T>>();
+      }
+      auto end_positions = reader.read_container<std::vector<ChunkOffset>>();
+      return std::make_shared<RunLengthSegment<T>>(std::move(values), std::move(end_positions));
+    }
+
+    case SegmentKind::FrameOfReference: {
+      auto minimum = reader.read_value<T>();
+      Assert(reader.read<AttributeVectorKind>() == AttributeVectorKind::BitPacked,
+             "read_binary_table: Frame of reference offsets have to be bit-packed");
+      return std::make_shared<FrameOfReferenceSegment<T>>(std::move(minimum),
+                                                          read_bit_packed_attribute_vector(reader));
+    }
+  }
+  Fail("read_binary_table: Unknown segment type");
+  return nullptr;
+}
+
+template <typename T>
+void write_zone_map(BinaryWriter& writer, const std::shared_ptr<const BaseZoneMap>& base_zone_map) {
+  const auto zone_map = std::dynamic_pointer_cast<const ZoneMap<T>>(base_zone_map);
+  writer.write_bool(zone_map != nullptr);
+  if (!zone_map) return;
+  writer.write_value(zone_map->min());
+  writer.write_value(zone_map->max());
+}
+
+template <typename T>
+std::shared_ptr<const BaseZoneMap> read_zone_map(BinaryReader& reader) {
+  if (!reader.read_bool()) return nullptr;
+  auto min = reader.read_value<T>();
+  auto max = reader.read_value<T>();
+  return std::make_shared<ZoneMap<T>>(min, max);
+}
+
+// writes the table to a new file, see write_binary_table
+void write_table(const Table& table, const std::string& file_name) {
+  auto writer = BinaryWriter{file_name};
+  writer.write(MAGIC);
+  writer.write(FORMAT_VERSION);
+  writer.write(table.chunk_size());
+  writer.write(table.column_count());
+  for (ColumnID column_id{0}; column_id < table.column_count(); ++column_id) {
+    writer.write_string(table.column_name(column_id));
+    writer.write_string(table.column_type(column_id));
+  }
+
+  writer.write(static_cast<uint32_t>(table.chunk_count()));
+  for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    const auto& chunk = table.get_chunk(chunk_id);
+    const auto has_zone_maps = table.column_count() > 0 && chunk.get_zone_map(ColumnID{0}) != nullptr;
+    writer.write_bool(has_zone_maps);
+    for (ColumnID column_id{0}; column_id < table.column_count(); ++column_id) {
+      resolve_data_type(table.column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        write_segment<ColumnDataType>(writer, *chunk.get_segment(column_id));
+        if (has_zone_maps) write_zone_map<ColumnDataType>(writer, chunk.get_zone_map(column_id));
+      });
+    }
+  }
+  writer.finish();
+}
+
+}  // namespace
+
+void write_binary_table(const Table& table, const std::string& file_name) {
+  // Tables read from an existing file keep it mapped, so it is replaced by a new file instead of being overwritten
+  const auto temporary_file_name = file_name + ".tmp";
+  try {
+    write_table(table, temporary_file_name);
+    std::filesystem::rename(temporary_file_name, file_name);
+  } catch (...) {
+    auto error_code = std::error_code{};
+    std::filesystem::remove(temporary_file_name, error_code);
+    throw;
+  }
+}
+
+std::shared_ptr<Table> read_binary_table(const std::string& file_name) {
+  return read_binary_table(std::make_shared<const MappedFile>(file_name));
+}
+
+std::shared_ptr<Table> read_binary_table(const std::shared_ptr<const MappedFile>& file) {
+  auto reader = BinaryReader{file};
+  Assert(reader.read<std::array<char, 8>>() == MAGIC, "read_binary_table: Not a binary table file");
+  Assert(reader.read<uint32_t>() == FORMAT_VERSION, "read_binary_table: Unsupported format version");
+
+  auto table = std::make_shared<Table>(reader.read<uint32_t>());
+  const auto column_count = reader.read<uint16_t>();
+  for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+    auto name = reader.read_string();
+    table->add_column_definition(name, reader.read_string());
+  }
+
+  const auto chunk_count = reader.read<uint32_t>();
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto has_zone_maps = reader.read_bool();
+    Chunk chunk;
+    std::vector<std::shared_ptr<const BaseZoneMap>> zone_maps;
+    for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+      resolve_data_type(table->column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        chunk.add_segment(read_segment<ColumnDataType>(reader));
+        if (has_zone_maps) zone_maps.emplace_back(read_zone_map<ColumnDataType>(reader));
+      });
+    }
+    if (has_zone_maps) chunk.set_zone_maps(zone_maps);
+    table->emplace_chunk(std::move(chunk));
+  }
+  return table;
+}
+
+}  // namespace opossum
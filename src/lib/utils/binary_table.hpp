@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace opossum {
+
+class MappedFile;
+class Table;
+
+// Writes a table to a file in a binary format that stores the segments of each chunk as they are laid out in memory:
+// value arrays, dictionaries, attribute vectors, runs, and zone maps. Arrays are aligned in the file like in memory.
+// Tables containing ReferenceSegments cannot be written. The table must not be modified while it is written. The table
+// is written to a temporary file that then replaces the file, so that tables read from the old file stay valid.
+void write_binary_table(const Table& table, const std::string& file_name);
+
+// Reads a table written by write_binary_table. The file is mapped into memory, and the attribute vectors of encoded
+// segments reference the mapped pages directly instead of copying them. All other arrays, i.e., values of
+// ValueSegments, dictionaries, runs, and membership filters, are copied as a whole, without parsing their values.
+// Chunks of encoded segments are not compressed again, see Table::emplace_chunk.
+std::shared_ptr<Table> read_binary_table(const std::string& file_name);
+
+// same as read_binary_table(const std::string&), but for a file that is mapped already. Segments referencing the file
+// keep it mapped.
+std::shared_ptr<Table> read_binary_table(const std::shared_ptr<const MappedFile>& file);
+
+}  // namespace opossum
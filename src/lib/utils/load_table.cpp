@@ -1,34 +1,289 @@
 #include "load_table.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <charconv>  // NOLINT(build/include_order)
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "resolve_type.hpp"
+#include "storage/segment_encoding_utils.hpp"
 #include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/parallel.hpp"
 
 namespace opossum {
 
-std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size) {
-  std::ifstream infile(file_name);
-  Assert(infile.is_open(), "load_table: Could not find file " + file_name);
+namespace {
 
-  std::string line;
-  std::getline(infile, line);
-  std::vector<std::string> column_names = _split<std::string>(line, '|');
-  std::getline(infile, line);
-  std::vector<std::string> column_types = _split<std::string>(line, '|');
+// returns the start of the line following the given position, or end if there is none
+const char* next_line(const char* position, const char* end) {
+  const auto* const line_break = static_cast<const char*>(std::memchr(position, '\n', end - position));
+  return line_break ? line_break + 1 : end;
+}
+
+// returns the line starting at the given position without its line break, which may be preceded by '\r'
+std::string_view line_at(const char* position, const char* end) {
+  const auto* line_end = static_cast<const char*>(std::memchr(position, '\n', end - position));
+  if (!line_end) line_end = end;
+  if (line_end > position && line_end[-1] == '\r') --line_end;
+  return std::string_view{position, static_cast<size_t>(line_end - position)};
+}
+
+// Appends the fields of a line to the given ones. Like with std::getline, a delimiter at the end of the line does not
+// start another field, so that lines written by dbgen, e.g., "1|x|", have as many fields as columns.
+void split_fields(std::string_view line, const char delimiter, std::vector<std::string_view>& fields) {
+  if (!line.empty() && line.back() == delimiter) line.remove_suffix(1);
+  for (auto field_end = line.find(delimiter); field_end != std::string_view::npos; field_end = line.find(delimiter)) {
+    fields.emplace_back(line.substr(0, field_end));
+    line.remove_prefix(field_end + 1);
+  }
+  fields.emplace_back(line);
+}
+
+std::vector<std::string> split_line(const std::string_view line, const char delimiter) {
+  std::vector<std::string_view> fields;
+  split_fields(line, delimiter, fields);
+  return std::vector<std::string>(fields.begin(), fields.end());
+}
+
+// Parses a floating-point number that spans the whole field. std::from_chars only supports floating-point types since
+// GCC 11, so strtof/strtod are used on a null-terminated copy of the field. Unlike std::from_chars, they skip leading
+// whitespace and accept a plus sign and hexadecimal numbers, which are rejected here for the same behavior. The
+// decimal point is that of the "C" locale, since the locale is never changed.
+template <typename T>
+bool parse_floating_point(const std::string_view field, T& value) {
+  if (field.empty() || std::isspace(static_cast<unsigned char>(field.front())) || field.front() == '+' ||
+      field.find_first_of("xX") != std::string_view::npos) {
+    return false;
+  }
+
+  // Fields are usually short, so they are copied to the stack
+  constexpr auto BUFFER_SIZE = size_t{64};
+  auto buffer = std::array<char, BUFFER_SIZE>{};
+  auto long_field = std::string{};
+  auto* terminated_field = buffer.data();
+  if (field.size() < BUFFER_SIZE) {
+    std::memcpy(buffer.data(), field.data(), field.size());
+  } else {
+    long_field = std::string{field};
+    terminated_field = long_field.data();
+  }
+
+  char* end = nullptr;
+  errno = 0;
+  if constexpr (std::is_same_v<T, float>) {
+    value = std::strtof(terminated_field, &end);
+  } else {
+    value = std::strtod(terminated_field, &end);
+  }
+  return errno == 0 && end == terminated_field + field.size();
+}
+
+// Parses a value of a column. Like type_cast, integral columns accept values with a fractional part, which are
+// truncated.
+template <typename T>
+T parse_value(const std::string_view field) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string(field);
+  } else {
+    auto value = T{};
+    if constexpr (std::is_floating_point_v<T>) {
+      if (parse_floating_point(field, value)) return value;
+    } else {
+      const auto* const end = field.data() + field.size();
+      const auto result = std::from_chars(field.data(), end, value);
+      if (result.ec == std::errc() && result.ptr == end) return value;
+
+      auto double_value = double{};
+      if (parse_floating_point(field, double_value) &&
+          double_value >= static_cast<double>(std::numeric_limits<T>::min()) &&
+          double_value <= static_cast<double>(std::numeric_limits<T>::max())) {
+        return static_cast<T>(double_value);
+      }
+    }
+    Fail("load_table: Could not parse value '" + std::string(field) + "'");
+    return value;
+  }
+}
+
+// Parses the lines in [begin, end) into a chunk with one ValueSegment per column. The fields of all lines are split
+// first, so that the data type of each column is only resolved once.
+Chunk parse_chunk(const char* begin, const char* const end, const std::vector<std::string>& column_types,
+                  const char delimiter) {
+  const auto column_count = column_types.size();
+  std::vector<std::string_view> fields;
+  auto row_count = size_t{0};
+  for (auto* line_begin = begin; line_begin < end; line_begin = next_line(line_begin, end), ++row_count) {
+    const auto first_field = fields.size();
+    split_fields(line_at(line_begin, end), delimiter, fields);
+    Assert(fields.size() - first_field == column_count,
+           "load_table: Line '" + std::string(line_at(line_begin, end)) + "' does not have " +
+               std::to_string(column_count) + " values");
+  }
 
-  std::shared_ptr<Table> test_table = std::make_shared<Table>(chunk_size);
-  for (size_t i = 0; i < column_names.size(); i++) {
-    test_table->add_column(column_names[i], column_types[i]);
+  Chunk chunk;
+  for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+    resolve_data_type(column_types[column_id], [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      ValueVector<ColumnDataType> values;
+      if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+        auto bytes = size_t{0};
+        for (auto row = size_t{0}; row < row_count; ++row) bytes += fields[row * column_count + column_id].size();
+        values.reserve(row_count, bytes);
+        for (auto row = size_t{0}; row < row_count; ++row) values.emplace_back(fields[row * column_count + column_id]);
+      } else {
+        values.reserve(row_count);
+        for (auto row = size_t{0}; row < row_count; ++row) {
+          values.emplace_back(parse_value<ColumnDataType>(fields[row * column_count + column_id]));
+        }
+      }
+      chunk.add_segment(std::make_shared<ValueSegment<ColumnDataType>>(std::move(values)));
+    });
   }
+  return chunk;
+}
+
+// Appends the values of the chunks in [begin, end), which consist of ValueSegments, to the first one and returns it.
+// The memory of each segment is allocated once, and the values of the other chunks are released as they are appended.
+Chunk merge_chunks(const std::vector<Chunk>::iterator begin, const std::vector<Chunk>::iterator end,
+                   const std::vector<std::string>& column_types) {
+  auto chunk = std::move(*begin);
+  for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
+    resolve_data_type(column_types[column_id], [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      const auto value_segment = [&](const Chunk& other_chunk) -> ValueSegment<ColumnDataType>& {
+        return static_cast<ValueSegment<ColumnDataType>&>(*other_chunk.get_segment(column_id));
+      };
+
+      auto& segment = value_segment(chunk);
+      auto count = segment.size();
+      auto bytes = size_t{0};
+      if constexpr (std::is_same_v<ColumnDataType, std::string>) bytes = segment.values().byte_count();
+      for (auto other_chunk = std::next(begin); other_chunk != end; ++other_chunk) {
+        count += value_segment(*other_chunk).size();
+        if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+          bytes += value_segment(*other_chunk).values().byte_count();
+        }
+      }
+      segment.reserve(count, bytes);
+      for (auto other_chunk = std::next(begin); other_chunk != end; ++other_chunk) {
+        segment.append_values(value_segment(*other_chunk).release_values());
+      }
+    });
+  }
+  return chunk;
+}
+
+}  // namespace
+
+std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size, const LoadTableOptions& options) {
+  const auto file = MappedFile{file_name};
+  const auto* position = file.data();
+  const auto* const end = file.data() + file.size();
+
+  const auto column_names = split_line(line_at(position, end), options.delimiter);
+  position = next_line(position, end);
+  const auto column_types = split_line(line_at(position, end), options.delimiter);
+  position = next_line(position, end);
+  Assert(column_names.size() == column_types.size(), "load_table: Number of column names and types does not match");
+
+  auto table = std::make_shared<Table>(chunk_size);
+  for (size_t column_id = 0; column_id < column_names.size(); ++column_id) {
+    table->add_column(column_names[column_id], column_types[column_id]);
+  }
+  chunk_size = table->chunk_size();
+
+  // Split the rows into blocks that begin at line starts and count their lines
+  const auto* const rows_begin = position;
+  const auto block_size = std::max(options.block_size, size_t{1});
+  const auto block_count = (static_cast<size_t>(end - rows_begin) + block_size - 1) / block_size;
+  std::vector<const char*> block_begins(block_count + 1, end);
+  std::vector<size_t> block_row_counts(block_count);
+  run_in_parallel(block_count, options.thread_count, [&](const size_t block_id) {
+    // A block starts at the first line that starts in it
+    const auto* const block_begin = rows_begin + block_id * block_size;
+    block_begins[block_id] = block_id == 0 ? block_begin : next_line(block_begin - 1, end);
+    const auto* const block_end = std::min(block_begin + block_size, end);
+    const auto* const lines_end = block_end == end ? end : next_line(block_end - 1, end);
+
+    auto row_count = static_cast<size_t>(std::count(block_begins[block_id], lines_end, '\n'));
+    if (lines_end == end && lines_end > block_begins[block_id] && end[-1] != '\n') ++row_count;
+    block_row_counts[block_id] = row_count;
+  });
+
+  // Find the line each chunk starts at. Only blocks containing the first row of a chunk have to be searched.
+  std::vector<size_t> block_first_rows(block_count + 1, 0);
+  for (size_t block_id = 0; block_id < block_count; ++block_id) {
+    block_first_rows[block_id + 1] = block_first_rows[block_id] + block_row_counts[block_id];
+  }
+  const auto row_count = block_first_rows.back();
+  const auto chunk_count = (row_count + chunk_size - 1) / chunk_size;
+  std::vector<const char*> chunk_begins(chunk_count + 1, end);
+  run_in_parallel(block_count, options.thread_count, [&](const size_t block_id) {
+    auto row = block_first_rows[block_id];
+    auto chunk_row = (row + chunk_size - 1) / chunk_size * chunk_size;
+    for (auto* line = block_begins[block_id]; chunk_row < block_first_rows[block_id + 1]; chunk_row += chunk_size) {
+      for (; row < chunk_row; ++row) line = next_line(line, end);
+      chunk_begins[chunk_row / chunk_size] = line;
+    }
+  });
+
+  // The rows are parsed in parts that end at both block and chunk boundaries, so that the work is split across threads
+  // even if all rows fit into a single chunk. All lines that begin at the same row begin at the same position.
+  std::vector<std::pair<size_t, const char*>> boundaries;
+  boundaries.reserve(block_count + chunk_count + 1);
+  for (size_t block_id = 0; block_id < block_count; ++block_id) {
+    boundaries.emplace_back(block_first_rows[block_id], block_begins[block_id]);
+  }
+  for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+    boundaries.emplace_back(chunk_index * chunk_size, chunk_begins[chunk_index]);
+  }
+  std::sort(boundaries.begin(), boundaries.end());
+  boundaries.emplace_back(row_count, end);
+
+  // The parts of a chunk are consecutive, chunk_first_parts[i] is the index of the first part of chunk i
+  std::vector<std::pair<const char*, const char*>> parts;
+  std::vector<size_t> chunk_first_parts(chunk_count + 1);
+  for (size_t boundary_id = 0; boundary_id + 1 < boundaries.size(); ++boundary_id) {
+    const auto first_row = boundaries[boundary_id].first;
+    if (first_row == boundaries[boundary_id + 1].first) continue;
+    if (first_row % chunk_size == 0) chunk_first_parts[first_row / chunk_size] = parts.size();
+    parts.emplace_back(boundaries[boundary_id].second, boundaries[boundary_id + 1].second);
+  }
+  chunk_first_parts[chunk_count] = parts.size();
+
+  std::vector<Chunk> part_chunks(parts.size());
+  run_in_parallel(parts.size(), options.thread_count, [&](const size_t part_id) {
+    part_chunks[part_id] = parse_chunk(parts[part_id].first, parts[part_id].second, column_types, options.delimiter);
+  });
+
+  std::vector<Chunk> chunks(chunk_count);
+  run_in_parallel(chunk_count, options.thread_count, [&](const size_t chunk_index) {
+    auto chunk = merge_chunks(part_chunks.begin() + chunk_first_parts[chunk_index],
+                              part_chunks.begin() + chunk_first_parts[chunk_index + 1], column_types);
+    if (chunk.size() == chunk_size) {
+      chunk = finish_chunk(std::move(chunk), column_types, options.encoding_type);
+    }
+    chunks[chunk_index] = std::move(chunk);
+  });
 
-  while (std::getline(infile, line)) {
-    std::vector<AllTypeVariant> values = _split<AllTypeVariant>(line, '|');
-    test_table->append(values);
+  for (auto& chunk : chunks) {
+    table->emplace_chunk(std::move(chunk));
   }
-  return test_table;
+  return table;
 }
 
 }  // namespace opossum
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "storage/encoding_type.hpp"
+
 namespace opossum {
 
 class Table;
@@ -22,7 +27,26 @@ std::vector<T> _split(const std::string& str, char delimiter) {
   return internal;
 }
 
+struct LoadTableOptions {
+  // separates the values of a row, e.g., ',' for CSV files. Values cannot be quoted.
+  char delimiter{'|'};
+
+  // If set, full chunks are encoded as soon as they are parsed. The last chunk stays unencoded if it is not full, so
+  // that rows can still be appended to it.
+  std::optional<EncodingType> encoding_type;
+
+  size_t thread_count{std::max(1u, std::thread::hardware_concurrency())};
+
+  // The file is split into blocks of this size, which are searched for line breaks in parallel
+  size_t block_size{size_t{1} << 22};
+};
+
+// Loads a table from a file whose first two lines hold the names and the types of the columns, followed by one line
+// per row. The file is mapped into memory and split into blocks at line breaks. Then, the blocks are parsed in
+// parallel, split further where chunks begin: the values of each column are parsed into a ValueSegment directly. The
+// parts of each chunk are concatenated, and full chunks get zone maps like chunks filled by Table::append.
 // This is a helper method which is heavily used in our test suite
-std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size);
+std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size,
+                                  const LoadTableOptions& options = {});
 
 }  // namespace opossum
@@ -0,0 +1,38 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+MappedFile::MappedFile(const std::string& file_name) {
+  const auto file_descriptor = open(file_name.c_str(), O_RDONLY);
+  Assert(file_descriptor >= 0, "MappedFile: Could not open file " + file_name);
+
+  struct stat file_stat;
+  const auto stat_result = fstat(file_descriptor, &file_stat);
+  _size = static_cast<size_t>(file_stat.st_size);
+  void* mapping = MAP_FAILED;
+  if (stat_result == 0 && _size > 0) {
+    mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  }
+
+  // The mapping stays valid after the file is closed
+  close(file_descriptor);
+  Assert(mapping != MAP_FAILED, "MappedFile: Could not map file " + file_name);
+  _data = static_cast<const char*>(mapping);
+}
+
+MappedFile::~MappedFile() { munmap(const_cast<char*>(_data), _size); }
+
+const char* MappedFile::data() const { return _data; }
+
+size_t MappedFile::size() const { return _size; }
+
+}  // namespace opossum
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// MappedFile maps a file into memory read-only. Pages are loaded from disk when they are first accessed, so opening a
+// file is cheap regardless of its size. The mapping is removed when the MappedFile is destroyed.
+class MappedFile : private Noncopyable {
+ public:
+  explicit MappedFile(const std::string& file_name);
+  ~MappedFile();
+
+  // returns the first byte of the file. The mapping is page-aligned.
+  const char* data() const;
+
+  // returns the size of the file in bytes
+  size_t size() const;
+
+ protected:
+  const char* _data;
+  size_t _size;
+};
+
+}  // namespace opossum
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opossum {
+
+// Calls function(task_index) for all tasks using up to thread_count threads and rethrows the first exception thrown
+// once all tasks are done. The threads take the tasks in ascending order of their indices. With a single thread or
+// task, the tasks are run by the calling thread.
+template <typename Function>
+void run_in_parallel(const size_t task_count, const size_t thread_count, const Function& function) {
+  auto next_task = std::atomic<size_t>{0};
+  auto exception_mutex = std::mutex{};
+  auto exception = std::exception_ptr{};
+  const auto run_tasks = [&] {
+    for (auto task_index = next_task++; task_index < task_count; task_index = next_task++) {
+      try {
+        function(task_index);
+      } catch (...) {
+        auto guard = std::lock_guard{exception_mutex};
+        if (!exception) exception = std::current_exception();
+      }
+    }
+  };
+
+  if (thread_count <= 1 || task_count <= 1) {
+    run_tasks();
+  } else {
+    std::vector<std::thread> threads;
+    for (size_t thread_id{0}; thread_id < std::min(thread_count, task_count); ++thread_id) {
+      threads.emplace_back(run_tasks);
+    }
+    for (auto& thread : threads) thread.join();
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+}  // namespace opossum
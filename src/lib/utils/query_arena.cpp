@@ -0,0 +1,27 @@
+#include "query_arena.hpp"
+
+#include <mutex>
+
+namespace opossum {
+
+QueryArena::QueryArena(const size_t initial_size, std::pmr::memory_resource* upstream)
+    : _resource{initial_size, upstream} {}
+
+size_t QueryArena::allocated_bytes() const {
+  auto guard = std::lock_guard{_mutex};
+  return _allocated_bytes;
+}
+
+void* QueryArena::do_allocate(const size_t bytes, const size_t alignment) {
+  auto guard = std::lock_guard{_mutex};
+  _allocated_bytes += bytes;
+  return _resource.allocate(bytes, alignment);
+}
+
+void QueryArena::do_deallocate(void*, size_t, size_t) {
+  // The memory is released when the arena is destroyed
+}
+
+bool QueryArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
+
+}  // namespace opossum
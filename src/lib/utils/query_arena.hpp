@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>  // NOLINT(build/include_order)
+#include <mutex>
+#include <utility>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// QueryArena is a memory resource for the intermediate results of the operators of a query, see
+// AbstractOperator::set_arena. Like std::pmr::monotonic_buffer_resource, it hands out memory from a few large blocks
+// and ignores deallocations. Thus, allocating is cheap and does not contend with other queries for the global
+// allocator, and all intermediates are freed in one shot once the arena is destroyed. Unlike
+// monotonic_buffer_resource, it can be used by multiple threads concurrently.
+//
+// Create arenas with std::make_shared, since the objects created by make_shared keep their arena alive.
+class QueryArena : public std::pmr::memory_resource,
+                   public std::enable_shared_from_this<QueryArena>,
+                   private Noncopyable {
+ public:
+  // the first block has the given size, each further block is larger than the previous one
+  explicit QueryArena(size_t initial_size = 64 * 1024,
+                      std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+  // Creates an object that allocates its memory from the arena, such as a PosList. The object's allocator is passed
+  // as the last constructor argument. The object keeps the arena alive, so that it may outlive the query.
+  template <typename T, typename... Args>
+  std::shared_ptr<T> make_shared(Args&&... args) {
+    auto* const object = new T(std::forward<Args>(args)..., static_cast<std::pmr::memory_resource*>(this));
+    return std::shared_ptr<T>(object, [arena = shared_from_this()](T* pointer) { delete pointer; });
+  }
+
+  // returns the number of bytes requested from the arena so far, including memory that was deallocated since
+  size_t allocated_bytes() const;
+
+ protected:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  mutable std::mutex _mutex;
+  std::pmr::monotonic_buffer_resource _resource;
+  size_t _allocated_bytes{0};
+};
+
+}  // namespace opossum
@@ -0,0 +1,255 @@
+#include "table_generator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel.hpp"
+
+namespace opossum {
+
+namespace {
+
+// splitmix64, which turns consecutive numbers into well-distributed seeds and hash values
+uint64_t mix(uint64_t value) {
+  value += 0x9E3779B97F4A7C15ULL;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+// The state of a column that is shared by the generation of all of its chunks
+struct ColumnGenerator {
+  ColumnGenerator(const ColumnSpecification& init_column, const uint64_t row_count, const uint64_t init_seed)
+      : column(init_column), seed(init_seed) {
+    Assert(column.distinct_value_count > 0, "generate_table: Column '" + column.name + "' needs a distinct value");
+    Assert(column.run_length > 0, "generate_table: Run length of column '" + column.name + "' must not be 0");
+    Assert(column.zipf_skew >= 0.0, "generate_table: Zipf skew of column '" + column.name + "' must not be negative");
+
+    distinct_value_count = column.distinct_value_count;
+    if (column.distribution == ValueDistribution::Sorted) {
+      distinct_value_count = std::max(std::min(distinct_value_count, row_count), uint64_t{1});
+    }
+
+    if (column.distribution == ValueDistribution::Zipf) {
+      zipf_cdf.resize(distinct_value_count);
+      auto sum = 0.0;
+      for (uint64_t number = 0; number < distinct_value_count; ++number) {
+        sum += 1.0 / std::pow(static_cast<double>(number + 1), column.zipf_skew);
+        zipf_cdf[number] = sum;
+      }
+      for (auto& probability : zipf_cdf) probability /= sum;
+    }
+  }
+
+  // Returns the number of the value of each row in [begin, end). The seed of a chunk only depends on its position, so
+  // that the chunks can be generated in any order.
+  std::vector<uint64_t> value_numbers(const uint64_t row_count, const uint64_t begin, const uint64_t end) const {
+    auto numbers = std::vector<uint64_t>(end - begin);
+    auto generator = std::mt19937_64{mix(seed ^ begin)};
+    switch (column.distribution) {
+      case ValueDistribution::Uniform: {
+        auto distribution = std::uniform_int_distribution<uint64_t>{0, distinct_value_count - 1};
+        for (auto& number : numbers) number = distribution(generator);
+        break;
+      }
+      case ValueDistribution::Zipf: {
+        auto distribution = std::uniform_real_distribution<double>{0.0, 1.0};
+        for (auto& number : numbers) {
+          const auto position = std::upper_bound(zipf_cdf.begin(), zipf_cdf.end(), distribution(generator));
+          number = std::min(static_cast<uint64_t>(position - zipf_cdf.begin()), distinct_value_count - 1);
+        }
+        break;
+      }
+      case ValueDistribution::Sorted: {
+        // The first row_count % distinct_value_count values get one row more than the others
+        const auto short_run_length = row_count / distinct_value_count;
+        const auto long_run_count = row_count % distinct_value_count;
+        const auto long_run_rows = long_run_count * (short_run_length + 1);
+        for (auto row = begin; row < end; ++row) {
+          numbers[row - begin] = row < long_run_rows ? row / (short_run_length + 1)
+                                                     : long_run_count + (row - long_run_rows) / short_run_length;
+        }
+        break;
+      }
+      case ValueDistribution::ClusteredRuns: {
+        // Runs may span chunks, so the value of a run is derived from the run rather than drawn from the generator
+        for (auto row = begin; row < end; ++row) {
+          numbers[row - begin] = mix(seed ^ mix(row / column.run_length)) % distinct_value_count;
+        }
+        break;
+      }
+    }
+    return numbers;
+  }
+
+  template <typename T>
+  std::shared_ptr<BaseSegment> generate_segment(const uint64_t row_count, const uint64_t begin,
+                                                const uint64_t end) const {
+    const auto numbers = value_numbers(row_count, begin, end);
+    ValueVector<T> values;
+    if constexpr (std::is_same_v<T, std::string>) {
+      const auto max_length = std::max(column.string_length, std::to_string(distinct_value_count - 1).size());
+      values.reserve(numbers.size(), numbers.size() * max_length);
+      auto string = std::string{};
+      for (const auto number : numbers) {
+        const auto digits = std::to_string(number);
+        string.assign(column.string_length > digits.size() ? column.string_length - digits.size() : 0, '0');
+        string += digits;
+        values.emplace_back(string);
+      }
+    } else {
+      values.reserve(numbers.size());
+      for (const auto number : numbers) values.emplace_back(static_cast<T>(number));
+    }
+    return std::make_shared<ValueSegment<T>>(std::move(values));
+  }
+
+  const ColumnSpecification& column;
+  const uint64_t seed;
+  uint64_t distinct_value_count;
+  std::vector<double> zipf_cdf;
+};
+
+}  // namespace
+
+std::shared_ptr<Table> generate_table(const std::vector<ColumnSpecification>& columns, const uint64_t row_count,
+                                      const TableGeneratorOptions& options) {
+  auto table = std::make_shared<Table>(options.chunk_size);
+  std::vector<std::string> column_types;
+  std::vector<ColumnGenerator> column_generators;
+  for (ColumnID column_id{0}; column_id < columns.size(); ++column_id) {
+    const auto& column = columns[column_id];
+    table->add_column(column.name, column.type);
+    column_types.emplace_back(column.type);
+    column_generators.emplace_back(column, row_count, mix(options.seed ^ mix(column_id)));
+
+    resolve_data_type(column.type, [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      if constexpr (std::is_integral_v<ColumnDataType>) {
+        Assert(column_generators.back().distinct_value_count - 1 <=
+                   static_cast<uint64_t>(std::numeric_limits<ColumnDataType>::max()),
+               "generate_table: Column '" + column.name + "' has more distinct values than its type can hold");
+      }
+    });
+  }
+
+  const auto chunk_size = table->chunk_size();
+  const auto chunk_count = (row_count + chunk_size - 1) / chunk_size;
+  std::vector<Chunk> chunks(chunk_count);
+  run_in_parallel(chunk_count, options.thread_count, [&](const size_t chunk_index) {
+    const auto begin = chunk_index * chunk_size;
+    const auto end = std::min(begin + chunk_size, row_count);
+    Chunk chunk;
+    for (ColumnID column_id{0}; column_id < columns.size(); ++column_id) {
+      resolve_data_type(column_types[column_id], [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        chunk.add_segment(column_generators[column_id].generate_segment<ColumnDataType>(row_count, begin, end));
+      });
+    }
+    if (chunk.size() == chunk_size) {
+      chunk = finish_chunk(std::move(chunk), column_types, options.encoding_type);
+    }
+    chunks[chunk_index] = std::move(chunk);
+  });
+
+  for (auto& chunk : chunks) {
+    table->emplace_chunk(std::move(chunk));
+  }
+  return table;
+}
+
+void generate_tables(const std::vector<TableSpecification>& tables, const TableGeneratorOptions& options) {
+  for (const auto& table : tables) {
+    StorageManager::get().add_table(table.name, generate_table(table.columns, table.row_count, options));
+  }
+}
+
+std::vector<TableSpecification> tpch_table_specifications(const double scale_factor) {
+  Assert(scale_factor > 0.0, "tpch_table_specifications: Scale factor must be positive");
+  const auto scaled = [&](const double row_count) {
+    return std::max(static_cast<uint64_t>(std::llround(row_count * scale_factor)), uint64_t{1});
+  };
+  const auto supplier_count = scaled(10'000);
+  const auto customer_count = scaled(150'000);
+  const auto part_count = scaled(200'000);
+  const auto order_count = scaled(1'500'000);
+
+  const auto column = [](const std::string& name, const std::string& type, const ValueDistribution distribution,
+                         const uint64_t distinct_value_count) {
+    auto specification = ColumnSpecification{};
+    specification.name = name;
+    specification.type = type;
+    specification.distribution = distribution;
+    specification.distinct_value_count = distinct_value_count;
+    return specification;
+  };
+  const auto key = [&](const std::string& name, const uint64_t count) {
+    return column(name, "int", ValueDistribution::Sorted, count);
+  };
+  const auto uniform = [&](const std::string& name, const std::string& type, const uint64_t distinct_value_count) {
+    return column(name, type, ValueDistribution::Uniform, distinct_value_count);
+  };
+  // categorical strings without leading zeros, e.g., "0" to "2" for l_returnflag
+  const auto flag = [&](const std::string& name, const uint64_t distinct_value_count) {
+    auto specification = uniform(name, "string", distinct_value_count);
+    specification.string_length = 1;
+    return specification;
+  };
+
+  auto quantity = column("l_quantity", "int", ValueDistribution::Zipf, 50);
+  // The line items of an order are shipped on dates close to each other
+  auto ship_date = column("l_shipdate", "int", ValueDistribution::ClusteredRuns, 2'526);
+  ship_date.run_length = 4;
+
+  return {
+      {"region", 5, {key("r_regionkey", 5), flag("r_name", 5)}},
+      {"nation", 25, {key("n_nationkey", 25), key("n_regionkey", 5), flag("n_name", 25)}},
+      {"supplier",
+       supplier_count,
+       {key("s_suppkey", supplier_count), uniform("s_nationkey", "int", 25),
+        uniform("s_acctbal", "double", 1'100'000)}},
+      {"customer",
+       customer_count,
+       {key("c_custkey", customer_count), uniform("c_nationkey", "int", 25), flag("c_mktsegment", 5),
+        uniform("c_acctbal", "double", 1'100'000)}},
+      {"part",
+       part_count,
+       {key("p_partkey", part_count), flag("p_brand", 25), flag("p_type", 150), uniform("p_size", "int", 50),
+        flag("p_container", 40), uniform("p_retailprice", "double", 120'000)}},
+      {"partsupp",
+       scaled(800'000),
+       {key("ps_partkey", part_count), uniform("ps_suppkey", "int", supplier_count),
+        uniform("ps_availqty", "int", 9'999), uniform("ps_supplycost", "double", 100'000)}},
+      {"orders",
+       order_count,
+       {key("o_orderkey", order_count), uniform("o_custkey", "int", customer_count), flag("o_orderstatus", 3),
+        uniform("o_totalprice", "double", order_count), uniform("o_orderdate", "int", 2'406),
+        flag("o_orderpriority", 5)}},
+      {"lineitem",
+       scaled(6'000'000),
+       {key("l_orderkey", order_count), uniform("l_partkey", "int", part_count),
+        uniform("l_suppkey", "int", supplier_count), uniform("l_linenumber", "int", 7), quantity,
+        uniform("l_extendedprice", "double", 1'000'000), uniform("l_discount", "double", 11),
+        uniform("l_tax", "double", 9), flag("l_returnflag", 3), flag("l_linestatus", 2), ship_date,
+        flag("l_shipmode", 7)}},
+  };
+}
+
+void generate_tpch_tables(const double scale_factor, const TableGeneratorOptions& options) {
+  generate_tables(tpch_table_specifications(scale_factor), options);
+}
+
+}  // namespace opossum
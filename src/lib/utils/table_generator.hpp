@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "storage/encoding_type.hpp"
+
+namespace opossum {
+
+class Table;
+
+// Describes how the values of a generated column are distributed. Each column draws its values from
+// distinct_value_count values, which are numbered 0, 1, ... in ascending order.
+enum class ValueDistribution {
+  // every value is equally likely
+  Uniform,
+  // The value with number k is chosen with a probability proportional to 1 / (k + 1)^zipf_skew, so that value 0 is the
+  // most frequent one. Drawing a value takes O(log distinct_value_count).
+  Zipf,
+  // The values appear in ascending order, each in a single run of row_count / distinct_value_count rows. A column with
+  // as many distinct values as rows holds the numbers of the rows, like a primary key.
+  Sorted,
+  // runs of run_length rows hold the same value, which is chosen uniformly for each run
+  ClusteredRuns
+};
+
+struct ColumnSpecification {
+  std::string name;
+
+  // one of the data types of AllTypeVariant. The value with number k is k for numeric columns, and k with leading
+  // zeros up to string_length digits for string columns, so that the order of the strings matches that of the numbers.
+  std::string type;
+
+  ValueDistribution distribution{ValueDistribution::Uniform};
+
+  // Sorted columns have at most one distinct value per row
+  uint64_t distinct_value_count{1000};
+
+  double zipf_skew{1.0};
+
+  uint64_t run_length{64};
+
+  size_t string_length{16};
+};
+
+struct TableSpecification {
+  std::string name;
+  uint64_t row_count;
+  std::vector<ColumnSpecification> columns;
+};
+
+struct TableGeneratorOptions {
+  uint32_t chunk_size{100'000};
+
+  // If set, full chunks are encoded as soon as they are generated, like with LoadTableOptions
+  std::optional<EncodingType> encoding_type;
+
+  size_t thread_count{std::max(1u, std::thread::hardware_concurrency())};
+
+  // The values of each chunk are drawn from a random generator seeded with the seed, the column, and the chunk. Thus,
+  // the same seed generates the same table regardless of the number of threads.
+  uint64_t seed{42};
+};
+
+// Generates a table with the given columns. The chunks are generated in parallel, directly into ValueSegments. Like
+// with load_table, full chunks get zone maps and are encoded, if requested, while the last one may be appended to.
+std::shared_ptr<Table> generate_table(const std::vector<ColumnSpecification>& columns, uint64_t row_count,
+                                      const TableGeneratorOptions& options = {});
+
+// Generates the given tables and adds them to the StorageManager
+void generate_tables(const std::vector<TableSpecification>& tables, const TableGeneratorOptions& options = {});
+
+// Returns the tables of TPC-H with their cardinalities at the given scale factor, e.g., 6'000'000 rows of lineitem at
+// scale factor 1. Only the columns that are commonly filtered on are generated. Keys are Sorted columns, and foreign
+// keys are uniformly distributed over the keys of the referenced table. Dates are days since 1992-01-01, and
+// categorical columns, e.g., l_returnflag, have as many distinct values as in TPC-H. Unlike in TPC-H, all orders have
+// the same number of line items and l_quantity is skewed (Zipf), so that scans see some skew.
+std::vector<TableSpecification> tpch_table_specifications(double scale_factor);
+
+// generates the TPC-H tables of the given scale factor and adds them to the StorageManager
+void generate_tpch_tables(double scale_factor, const TableGeneratorOptions& options = {});
+
+}  // namespace opossum
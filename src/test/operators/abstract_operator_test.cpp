@@ -0,0 +1,81 @@
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "utils/query_arena.hpp"
+
+namespace opossum {
+
+class OperatorsAbstractOperatorTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto table = std::make_shared<Table>(10);
+    table->add_column("a", "int");
+    for (int i = 0; i < 100; ++i) table->append({i});
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsAbstractOperatorTest, RecordsPerformanceData) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 50);
+  scan->set_arena(std::make_shared<QueryArena>());
+  scan->execute();
+
+  const auto& data = scan->performance_data();
+  EXPECT_GT(data.walltime.count(), 0);
+  EXPECT_EQ(data.left_input_row_count, 100u);
+  // Appending the last row created an empty chunk
+  EXPECT_EQ(data.left_input_chunk_count, 11u);
+  EXPECT_EQ(data.right_input_row_count, 0u);
+  EXPECT_EQ(data.output_row_count, 50u);
+  EXPECT_EQ(data.output_chunk_count, 5u);
+  EXPECT_EQ(data.output_memory_usage, scan->get_output()->estimate_memory_usage());
+  // Scans selecting many rows of a table build RowIDBitmaps, which are not allocated from the arena, while scans of
+  // ReferenceSegments collect their positions in PosLists from the arena
+  EXPECT_EQ(data.arena_allocated_bytes, 0u);
+  auto reference_scan = std::make_shared<TableScan>(scan, ColumnID{0}, ScanType::OpLessThan, 70);
+  reference_scan->set_arena(std::make_shared<QueryArena>());
+  reference_scan->execute();
+  EXPECT_GT(reference_scan->performance_data().arena_allocated_bytes, 0u);
+
+  EXPECT_EQ(_table_wrapper->performance_data().output_row_count, 100u);
+  EXPECT_EQ(_table_wrapper->performance_data().arena_allocated_bytes, 0u);
+}
+
+TEST_F(OperatorsAbstractOperatorTest, PrintsPlan) {
+  auto scan_1 = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 50);
+  auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{0}, ScanType::OpLessThan, 70);
+
+  auto stream = std::ostringstream{};
+  scan_2->print_plan(stream);
+  EXPECT_EQ(stream.str().substr(0, stream.str().find('\n')), "TableScan #0 < 70 | not executed");
+
+  scan_1->execute();
+  scan_2->execute();
+  stream.str("");
+  scan_2->print_plan(stream);
+
+  auto lines = std::istringstream{stream.str()};
+  auto line = std::string{};
+  std::getline(lines, line);
+  EXPECT_EQ(line.find("TableScan a < 70 | "), 0u);
+  EXPECT_NE(line.find(" | rows: 50 -> 20 | chunks: 5 -> 2 | output: "), std::string::npos);
+  std::getline(lines, line);
+  EXPECT_EQ(line.find("  TableScan a >= 50 | "), 0u);
+  EXPECT_NE(line.find(" | rows: 100 -> 50 | chunks: 11 -> 5 | "), std::string::npos);
+  std::getline(lines, line);
+  EXPECT_EQ(line.find("    TableWrapper | "), 0u);
+  EXPECT_NE(line.find(" | rows: 100 | chunks: 11 | "), std::string::npos);
+  EXPECT_FALSE(std::getline(lines, line));
+}
+
+}  // namespace opossum
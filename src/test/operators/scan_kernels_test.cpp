@@ -0,0 +1,99 @@
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/scan_kernels.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsScanKernelsTest : public BaseTest {
+ protected:
+  template <typename T>
+  static PosList reference_scan(const std::vector<T>& codes, ScanType scan_type, T search_code,
+                                ChunkOffset first_offset) {
+    PosList pos_list;
+    for (ChunkOffset offset{0}; offset < codes.size(); ++offset) {
+      const auto code = codes[offset];
+      auto matches = false;
+      switch (scan_type) {
+        case ScanType::OpEquals:
+          matches = code == search_code;
+          break;
+        case ScanType::OpNotEquals:
+          matches = code != search_code;
+          break;
+        case ScanType::OpLessThan:
+          matches = code < search_code;
+          break;
+        case ScanType::OpLessThanEquals:
+          matches = code <= search_code;
+          break;
+        case ScanType::OpGreaterThan:
+          matches = code > search_code;
+          break;
+        case ScanType::OpGreaterThanEquals:
+          matches = code >= search_code;
+          break;
+      }
+      if (matches) pos_list.emplace_back(RowID{ChunkID{3}, first_offset + offset});
+    }
+    return pos_list;
+  }
+
+  // Compares all supported kernel sets against a straightforward scan. The number of codes is chosen so that the
+  // SIMD kernels also have to process a tail that does not fill an entire block.
+  template <typename T>
+  static void test_all_kernels(const T max_code) {
+    auto generator = std::mt19937{42};
+    auto distribution = std::uniform_int_distribution<uint32_t>{0, max_code};
+    auto codes = std::vector<T>(1037);
+    for (auto& code : codes) code = static_cast<T>(distribution(generator));
+    codes[5] = std::numeric_limits<T>::max();
+
+    const auto search_codes =
+        std::vector<T>{0, static_cast<T>(max_code / 2), max_code, std::numeric_limits<T>::max()};
+    const auto scan_types = {ScanType::OpEquals,         ScanType::OpNotEquals,   ScanType::OpLessThan,
+                             ScanType::OpLessThanEquals, ScanType::OpGreaterThan, ScanType::OpGreaterThanEquals};
+    const auto kernel_sets = {ScanKernelSet::Scalar, ScanKernelSet::SSE42, ScanKernelSet::AVX2};
+
+    for (const auto kernel_set : kernel_sets) {
+      if (!scan_kernel_set_supported(kernel_set)) continue;
+
+      for (const auto scan_type : scan_types) {
+        for (const auto search_code : search_codes) {
+          PosList pos_list;
+          scan_codes(codes.data(), codes.size(), scan_type, search_code, ChunkID{3}, 17, pos_list, kernel_set);
+          EXPECT_EQ(pos_list, reference_scan(codes, scan_type, search_code, 17));
+        }
+      }
+    }
+  }
+};
+
+TEST_F(OperatorsScanKernelsTest, ScalarIsAlwaysSupported) {
+  EXPECT_TRUE(scan_kernel_set_supported(ScanKernelSet::Scalar));
+  EXPECT_TRUE(scan_kernel_set_supported(detect_scan_kernel_set()));
+}
+
+TEST_F(OperatorsScanKernelsTest, ScanUint8Codes) { test_all_kernels<uint8_t>(200); }
+
+TEST_F(OperatorsScanKernelsTest, ScanUint16Codes) { test_all_kernels<uint16_t>(40000); }
+
+TEST_F(OperatorsScanKernelsTest, ScanUint32Codes) { test_all_kernels<uint32_t>(3000000000u); }
+
+TEST_F(OperatorsScanKernelsTest, AppendsToExistingPositions) {
+  const auto codes = std::vector<uint8_t>(40, 7);
+  PosList pos_list{RowID{ChunkID{0}, 0}};
+  scan_codes(codes.data(), codes.size(), ScanType::OpEquals, uint8_t{7}, ChunkID{1}, 0, pos_list);
+
+  ASSERT_EQ(pos_list.size(), 41u);
+  EXPECT_EQ(pos_list[0], (RowID{ChunkID{0}, 0}));
+  EXPECT_EQ(pos_list[1], (RowID{ChunkID{1}, 0}));
+  EXPECT_EQ(pos_list[40], (RowID{ChunkID{1}, 39}));
+}
+
+}  // namespace opossum
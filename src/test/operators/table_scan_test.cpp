@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
@@ -13,10 +14,13 @@
 #include "operators/print.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/dictionary_segment.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
+#include "storage/zone_map.hpp"
 #include "types.hpp"
 #include "utils/load_table.hpp"
+#include "utils/query_arena.hpp"
 
 namespace opossum {
 
@@ -156,6 +160,340 @@ TEST_F(OperatorsTableScanTest, ScanOnDictColumn) {
   }
 }
 
+TEST_F(OperatorsTableScanTest, ScanOnRunLengthColumn) {
+  auto table = std::make_shared<Table>(12);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  for (int i = 0; i < 12; ++i) table->append({i / 3, 100 + i});
+  table->compress_chunk(ChunkID{0}, EncodingType::RunLength);
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  std::map<ScanType, std::vector<AllTypeVariant>> tests;
+  tests[ScanType::OpEquals] = {106, 107, 108};
+  tests[ScanType::OpNotEquals] = {100, 101, 102, 103, 104, 105, 109, 110, 111};
+  tests[ScanType::OpLessThan] = {100, 101, 102, 103, 104, 105};
+  tests[ScanType::OpLessThanEquals] = {100, 101, 102, 103, 104, 105, 106, 107, 108};
+  tests[ScanType::OpGreaterThan] = {109, 110, 111};
+  tests[ScanType::OpGreaterThanEquals] = {106, 107, 108, 109, 110, 111};
+  for (const auto& test : tests) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, test.first, 2);
+    scan->execute();
+    ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, test.second);
+
+    // Scanning a ReferenceSegment that references the run length encoded segments
+    auto scan_all = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, ScanType::OpGreaterThanEquals, 100);
+    scan_all->execute();
+    auto scan_reference = std::make_shared<TableScan>(scan_all, ColumnID{0}, test.first, 2);
+    scan_reference->execute();
+    ASSERT_COLUMN_EQ(scan_reference->get_output(), ColumnID{1}, test.second);
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnFrameOfReferenceColumn) {
+  auto table = std::make_shared<Table>(12);
+  table->add_column("a", "long");
+  table->add_column("b", "int");
+  for (int i = 0; i < 12; ++i) table->append({int64_t{1'000'000'000'000} + i * 5, 100 + i});
+  table->compress_chunk(ChunkID{0}, EncodingType::FrameOfReference);
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  std::map<ScanType, std::vector<AllTypeVariant>> tests;
+  tests[ScanType::OpEquals] = {104};
+  tests[ScanType::OpNotEquals] = {100, 101, 102, 103, 105, 106, 107, 108, 109, 110, 111};
+  tests[ScanType::OpLessThan] = {100, 101, 102, 103};
+  tests[ScanType::OpLessThanEquals] = {100, 101, 102, 103, 104};
+  tests[ScanType::OpGreaterThan] = {105, 106, 107, 108, 109, 110, 111};
+  tests[ScanType::OpGreaterThanEquals] = {104, 105, 106, 107, 108, 109, 110, 111};
+  for (const auto& test : tests) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, test.first, int64_t{1'000'000'000'020});
+    scan->execute();
+    ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, test.second);
+
+    // Scanning a ReferenceSegment that references the frame of reference encoded segments
+    auto scan_all = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, ScanType::OpGreaterThanEquals, 100);
+    scan_all->execute();
+    auto scan_reference = std::make_shared<TableScan>(scan_all, ColumnID{0}, test.first, int64_t{1'000'000'000'020});
+    scan_reference->execute();
+    ASSERT_COLUMN_EQ(scan_reference->get_output(), ColumnID{1}, test.second);
+  }
+
+  // Search values below the minimum and beyond the largest representable offset match all or none of the rows
+  auto scan_below = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, int64_t{-5});
+  scan_below->execute();
+  EXPECT_EQ(scan_below->get_output()->row_count(), 12u);
+  auto scan_above =
+      std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, int64_t{1'000'000'000'064});
+  scan_above->execute();
+  EXPECT_EQ(scan_above->get_output()->row_count(), 0u);
+  auto scan_far_above = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThanEquals,
+                                                    std::numeric_limits<int64_t>::max());
+  scan_far_above->execute();
+  EXPECT_EQ(scan_far_above->get_output()->row_count(), 12u);
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnFrontCodedDictionaryColumn) {
+  auto table = std::make_shared<Table>(40);
+  table->add_column("a", "string");
+  table->add_column("b", "int");
+  for (int i = 0; i < 40; ++i) table->append({"https://example.com/" + std::to_string(10 + i % 20), 100 + i});
+  table->compress_chunk(ChunkID{0}, EncodingType::FrontCodedDictionary);
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  std::map<ScanType, std::vector<AllTypeVariant>> tests;
+  tests[ScanType::OpEquals] = {116, 136};
+  tests[ScanType::OpNotEquals] = {100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113,
+                                  114, 115, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128,
+                                  129, 130, 131, 132, 133, 134, 135, 137, 138, 139};
+  tests[ScanType::OpGreaterThan] = {117, 118, 119, 137, 138, 139};
+  tests[ScanType::OpGreaterThanEquals] = {116, 117, 118, 119, 136, 137, 138, 139};
+  const auto search_value = std::string{"https://example.com/26"};
+  for (const auto& test : tests) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, test.first, search_value);
+    scan->execute();
+    ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, test.second);
+
+    // Scanning a ReferenceSegment that references the front coded dictionary segments
+    auto scan_all = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, ScanType::OpGreaterThanEquals, 100);
+    scan_all->execute();
+    auto scan_reference = std::make_shared<TableScan>(scan_all, ColumnID{0}, test.first, search_value);
+    scan_reference->execute();
+    ASSERT_COLUMN_EQ(scan_reference->get_output(), ColumnID{1}, test.second);
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanUsesZoneMaps) {
+  auto table = std::make_shared<Table>(5);
+  table->add_column("a", "int");
+  for (int i = 0; i < 20; ++i) table->append({i});
+  table->compress_chunk(ChunkID{1});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  std::map<ScanType, std::vector<AllTypeVariant>> tests;
+  tests[ScanType::OpEquals] = {7};
+  tests[ScanType::OpNotEquals] = {0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+  tests[ScanType::OpLessThan] = {0, 1, 2, 3, 4, 5, 6};
+  tests[ScanType::OpLessThanEquals] = {0, 1, 2, 3, 4, 5, 6, 7};
+  tests[ScanType::OpGreaterThan] = {8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+  tests[ScanType::OpGreaterThanEquals] = {7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+  for (const auto& test : tests) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, test.first, 7);
+    scan->execute();
+    ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{0}, test.second);
+  }
+
+  // The scan relies on the zone maps instead of the data. This is observable by replacing them with wrong ones.
+  table->get_chunk(ChunkID{2}).set_zone_maps({std::make_shared<ZoneMap<int>>(100, 200)});
+  auto scan_pruned = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, 12);
+  scan_pruned->execute();
+  ASSERT_COLUMN_EQ(scan_pruned->get_output(), ColumnID{0}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+  auto scan_all = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 12);
+  scan_all->execute();
+  ASSERT_COLUMN_EQ(scan_all->get_output(), ColumnID{0}, {10, 11, 12, 13, 14, 15, 16, 17, 18, 19});
+}
+
+TEST_F(OperatorsTableScanTest, ScanEqualsOnDictionaryWithMembershipFilter) {
+  auto table = std::make_shared<Table>(1000);
+  table->add_column("a", "int");
+  for (int i = 0; i < 1000; ++i) table->append({(i * 7919) % 1000 * 2});
+  table->compress_chunk(ChunkID{0});
+  ASSERT_NE(std::static_pointer_cast<DictionarySegment<int>>(table->get_chunk(ChunkID{0}).get_segment(ColumnID{0}))
+                ->membership_filter(),
+            nullptr);
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // Odd values are not in the dictionary
+  for (const auto search_value : {500, 501, 1998, 1999}) {
+    auto scan_equals = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, search_value);
+    scan_equals->execute();
+    EXPECT_EQ(scan_equals->get_output()->row_count(), search_value % 2 == 0 ? 1u : 0u);
+
+    auto scan_not_equals = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpNotEquals, search_value);
+    scan_not_equals->execute();
+    EXPECT_EQ(scan_not_equals->get_output()->row_count(), search_value % 2 == 0 ? 999u : 1000u);
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ChoosesPositionRepresentationBySelectivity) {
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "int");
+  for (int i = 0; i < 1000; ++i) table->append({i});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto output_segment = [](const std::shared_ptr<const AbstractOperator>& scan) {
+    return std::dynamic_pointer_cast<const ReferenceSegment>(
+        scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  };
+
+  // Selective scans produce a PosList
+  auto selective_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 995);
+  selective_scan->execute();
+  ASSERT_NE(output_segment(selective_scan)->pos_list(), nullptr);
+  EXPECT_EQ(output_segment(selective_scan)->size(), 4u);
+
+  // Scans matching many rows produce a RowIDBitmap, which later scans can consume
+  auto broad_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 500);
+  broad_scan->execute();
+  ASSERT_NE(output_segment(broad_scan)->row_id_bitmap(), nullptr);
+  EXPECT_EQ(output_segment(broad_scan)->size(), 100u);
+  EXPECT_EQ(broad_scan->get_output()->row_count(), 500u);
+
+  auto scan_on_bitmap = std::make_shared<TableScan>(broad_scan, ColumnID{0}, ScanType::OpLessThan, 503);
+  scan_on_bitmap->execute();
+  ASSERT_COLUMN_EQ(scan_on_bitmap->get_output(), ColumnID{0}, {500, 501, 502});
+}
+
+TEST_F(OperatorsTableScanTest, EmitsOneChunkPerInputChunk) {
+  auto table = std::make_shared<Table>(10);
+  table->add_column("a", "int");
+  for (int i = 0; i < 50; ++i) table->append({i});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // Chunks without matches do not produce output chunks
+  auto scan_1 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 15);
+  scan_1->execute();
+  auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{0}, ScanType::OpLessThan, 35);
+  scan_2->execute();
+
+  const auto output = scan_2->get_output();
+  ASSERT_EQ(output->chunk_count(), 3u);
+  for (ChunkID chunk_id{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto segment =
+        std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(chunk_id).get_segment(ColumnID{0}));
+    ASSERT_NE(segment, nullptr);
+    EXPECT_TRUE(segment->references_single_chunk());
+    EXPECT_EQ(segment->referenced_table(), table);
+    segment->for_each_row_id([&](const RowID& row_id) { EXPECT_EQ(row_id.chunk_id, chunk_id + 1); });
+  }
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).size(), 5u);
+  EXPECT_EQ(output->get_chunk(ChunkID{1}).size(), 10u);
+  EXPECT_EQ(output->get_chunk(ChunkID{2}).size(), 5u);
+}
+
+TEST_F(OperatorsTableScanTest, ParallelScanMatchesSerialScan) {
+  // Chunks span several morsels, and runs of equal values span morsel boundaries
+  auto table = std::make_shared<Table>(50'000);
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+  for (int i = 0; i < 170'000; ++i) table->append({i / 37 * 7 % 1000, std::to_string(i % 3)});
+  table->compress_chunk(ChunkID{0}, EncodingType::Dictionary);
+  table->compress_chunk(ChunkID{1}, EncodingType::RunLength);
+  table->compress_chunk(ChunkID{2}, {EncodingType::FrameOfReference, EncodingType::Dictionary});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto scan = [&](const std::shared_ptr<const AbstractOperator>& input, const ScanType scan_type,
+                        const AllTypeVariant& search_value, const size_t thread_count) {
+    auto table_scan = std::make_shared<TableScan>(input, ColumnID{0}, scan_type, search_value);
+    table_scan->set_thread_count(thread_count);
+    table_scan->execute();
+    return table_scan;
+  };
+  const auto row_ids_by_chunk = [](const std::shared_ptr<const AbstractOperator>& table_scan) {
+    std::vector<PosList> row_ids;
+    const auto output = table_scan->get_output();
+    for (ChunkID chunk_id{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+      row_ids.emplace_back();
+      const auto segment =
+          std::static_pointer_cast<const ReferenceSegment>(output->get_chunk(chunk_id).get_segment(ColumnID{1}));
+      segment->for_each_row_id([&](const RowID& row_id) { row_ids.back().emplace_back(row_id); });
+    }
+    return row_ids;
+  };
+
+  for (const auto scan_type : {ScanType::OpEquals, ScanType::OpNotEquals, ScanType::OpLessThan,
+                               ScanType::OpLessThanEquals, ScanType::OpGreaterThan, ScanType::OpGreaterThanEquals}) {
+    for (const auto search_value : {-1, 497, 1000}) {
+      const auto serial_scan = scan(table_wrapper, scan_type, search_value, 1);
+      const auto parallel_scan = scan(table_wrapper, scan_type, search_value, 4);
+      EXPECT_EQ(row_ids_by_chunk(parallel_scan), row_ids_by_chunk(serial_scan));
+
+      // Scans on the output of a scan are parallelized by chunk
+      EXPECT_EQ(row_ids_by_chunk(scan(serial_scan, ScanType::OpNotEquals, 7, 4)),
+                row_ids_by_chunk(scan(serial_scan, ScanType::OpNotEquals, 7, 1)));
+    }
+  }
+
+  auto expected_row_count = size_t{0};
+  for (int i = 0; i < 170'000; ++i) expected_row_count += i / 37 * 7 % 1000 < 497;
+  EXPECT_EQ(scan(table_wrapper, ScanType::OpLessThan, 497, 4)->get_output()->row_count(), expected_row_count);
+}
+
+TEST_F(OperatorsTableScanTest, CombinesMatchesOfMorsels) {
+  // The chunk spans several morsels. Morsels selecting many of their rows keep their matches as bits, which become
+  // part of a RowIDBitmap or of a PosList, depending on the share of the chunk that is selected.
+  auto table = std::make_shared<Table>(100'000);
+  table->add_column("a", "int");
+  for (int i = 0; i < 100'000; ++i) table->append({i});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto scan = [&](const ScanType scan_type, const int search_value) {
+    auto table_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan_type, search_value);
+    table_scan->set_thread_count(4);
+    table_scan->execute();
+    return std::static_pointer_cast<const ReferenceSegment>(
+        table_scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  };
+  const auto expect_offsets = [](const std::shared_ptr<const ReferenceSegment>& segment, const ChunkOffset begin,
+                                 const ChunkOffset end) {
+    auto offset = begin;
+    segment->for_each_row_id([&](const RowID& row_id) {
+      EXPECT_EQ(row_id, (RowID{ChunkID{0}, offset}));
+      ++offset;
+    });
+    EXPECT_EQ(offset, end);
+  };
+
+  const auto broad_scan = scan(ScanType::OpLessThan, 20'000);
+  ASSERT_NE(broad_scan->row_id_bitmap(), nullptr);
+  expect_offsets(broad_scan, 0, 20'000);
+
+  const auto selective_scan = scan(ScanType::OpGreaterThanEquals, 99'000);
+  ASSERT_NE(selective_scan->pos_list(), nullptr);
+  expect_offsets(selective_scan, 99'000, 100'000);
+}
+
+TEST_F(OperatorsTableScanTest, ScanDuringAutoCompression) {
+  // The workers replace the segments of the chunks while they are scanned, directly and through ReferenceSegments
+  auto table = std::make_shared<Table>(1'000);
+  table->add_column("a", "int");
+  std::vector<int32_t> values(200'000);
+  for (size_t row = 0; row < values.size(); ++row) values[row] = static_cast<int32_t>(row % 1'000);
+  table->append_columns(std::move(values));
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto last_full_chunk = ChunkID{199};
+  const auto is_compressed = [&] {
+    return std::dynamic_pointer_cast<DictionarySegment<int>>(
+               table->get_chunk(last_full_chunk).get_segment(ColumnID{0})) != nullptr;
+  };
+  const auto scan_and_check = [&] {
+    auto table_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, 500);
+    table_scan->set_thread_count(2);
+    table_scan->execute();
+    EXPECT_EQ(table_scan->get_output()->row_count(), 100'000u);
+
+    auto reference_scan = std::make_shared<TableScan>(table_scan, ColumnID{0}, ScanType::OpGreaterThanEquals, 250);
+    reference_scan->execute();
+    EXPECT_EQ(reference_scan->get_output()->row_count(), 50'000u);
+  };
+
+  table->enable_auto_compression(2);
+  for (auto scan_count = 0; scan_count < 100 && !is_compressed(); ++scan_count) scan_and_check();
+  table->disable_auto_compression();
+
+  EXPECT_TRUE(is_compressed());
+  scan_and_check();
+}
+
 TEST_F(OperatorsTableScanTest, ScanOnReferencedDictColumn) {
   // we do not need to check for a non existing value, because that happens automatically when we scan the second chunk
 
@@ -275,4 +613,27 @@ TEST_F(OperatorsTableScanTest, ScanOnWideDictionarySegment) {
   EXPECT_EQ(scan_2->get_output()->row_count(), static_cast<size_t>(37));
 }
 
+TEST_F(OperatorsTableScanTest, ScanAllocatesPositionsFromArena) {
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "int");
+  for (int i = 0; i < 1000; ++i) table->append({i});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto arena = std::make_shared<QueryArena>();
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 996);
+  scan->set_arena(arena);
+  scan->execute();
+  EXPECT_GT(arena->allocated_bytes(), 0u);
+
+  const auto segment = std::dynamic_pointer_cast<const ReferenceSegment>(
+      scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  ASSERT_NE(segment->pos_list(), nullptr);
+  EXPECT_EQ(segment->pos_list()->get_allocator().resource(), arena.get());
+
+  // The positions keep the arena alive
+  arena.reset();
+  ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{0}, {997, 998, 999});
+}
+
 }  // namespace opossum
@@ -0,0 +1,140 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/operator_task.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class NodeQueueSchedulerTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(10);
+    _table->add_column("a", "int");
+    for (int i = 0; i < 100; ++i) _table->append({i});
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(NodeQueueSchedulerTest, ExecutesTasksInDependencyOrder) {
+  auto mutex = std::mutex{};
+  auto order = std::vector<int>{};
+  const auto make_task = [&](const int id) {
+    return std::make_shared<JobTask>([&, id] {
+      auto guard = std::lock_guard{mutex};
+      order.emplace_back(id);
+    });
+  };
+
+  // 0 -> {1, 2} -> 3
+  const auto make_graph = [&] {
+    const auto tasks =
+        std::vector<std::shared_ptr<AbstractTask>>{make_task(0), make_task(1), make_task(2), make_task(3)};
+    tasks[0]->set_as_predecessor_of(tasks[1]);
+    tasks[0]->set_as_predecessor_of(tasks[2]);
+    tasks[1]->set_as_predecessor_of(tasks[3]);
+    tasks[2]->set_as_predecessor_of(tasks[3]);
+    return tasks;
+  };
+
+  for (const auto worker_count : {size_t{1}, size_t{4}}) {
+    order.clear();
+    const auto tasks = make_graph();
+    EXPECT_TRUE(tasks[0]->is_ready());
+    EXPECT_FALSE(tasks[3]->is_ready());
+
+    auto scheduler = NodeQueueScheduler{worker_count};
+    EXPECT_EQ(scheduler.worker_count(), worker_count);
+    scheduler.schedule_and_wait(tasks);
+
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order.front(), 0);
+    EXPECT_EQ(order.back(), 3);
+    for (const auto& task : tasks) EXPECT_TRUE(task->is_done());
+  }
+}
+
+TEST_F(NodeQueueSchedulerTest, ExecutesIndependentTasksConcurrently) {
+  // Each task waits for the other one to start, which only succeeds if they run at the same time
+  auto started_count = std::atomic<int>{0};
+  auto met_count = std::atomic<int>{0};
+  const auto meet = [&] {
+    ++started_count;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (started_count < 2 && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+    if (started_count == 2) ++met_count;
+  };
+
+  auto scheduler = NodeQueueScheduler{2, true};
+  scheduler.schedule({std::make_shared<JobTask>(meet), std::make_shared<JobTask>(meet)});
+  scheduler.wait_for_all_tasks();
+  EXPECT_EQ(met_count, 2);
+}
+
+TEST_F(NodeQueueSchedulerTest, ManyTasks) {
+  auto counter = std::atomic<size_t>{0};
+  auto scheduler = NodeQueueScheduler{4};
+
+  // Each root task has a chain of successors, which its worker executes next while other workers may steal roots
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto chain = 0; chain < 100; ++chain) {
+    for (auto link = 0; link < 10; ++link) {
+      tasks.emplace_back(std::make_shared<JobTask>([&] { ++counter; }));
+      if (link > 0) tasks[tasks.size() - 2]->set_as_predecessor_of(tasks.back());
+    }
+  }
+  scheduler.schedule(tasks);
+  scheduler.wait_for_all_tasks();
+  EXPECT_EQ(counter, 1000u);
+}
+
+TEST_F(NodeQueueSchedulerTest, PassesExceptionsToSuccessors) {
+  auto successor_executed = false;
+  const auto failing_task = std::make_shared<JobTask>([] { throw std::logic_error("failed"); });
+  const auto successor = std::make_shared<JobTask>([&] { successor_executed = true; });
+  failing_task->set_as_predecessor_of(successor);
+
+  auto scheduler = NodeQueueScheduler{2};
+  EXPECT_THROW(scheduler.schedule_and_wait({failing_task, successor}), std::logic_error);
+  EXPECT_TRUE(successor->is_done());
+  EXPECT_THROW(successor->join(), std::logic_error);
+  EXPECT_FALSE(successor_executed);
+}
+
+TEST_F(NodeQueueSchedulerTest, ExecutesOperators) {
+  auto table_wrapper = std::make_shared<TableWrapper>(_table);
+  auto scan_1 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 20);
+  auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{0}, ScanType::OpLessThan, 30);
+
+  const auto tasks = OperatorTask::make_tasks_from_operator(scan_2);
+  ASSERT_EQ(tasks.size(), 3u);
+  EXPECT_EQ(std::static_pointer_cast<OperatorTask>(tasks[0])->get_operator(), table_wrapper);
+  EXPECT_EQ(std::static_pointer_cast<OperatorTask>(tasks[2])->get_operator(), scan_2);
+  EXPECT_EQ(tasks[0]->successors(), std::vector<std::shared_ptr<AbstractTask>>{tasks[1]});
+  EXPECT_EQ(tasks[1]->successors(), std::vector<std::shared_ptr<AbstractTask>>{tasks[2]});
+
+  auto scheduler = NodeQueueScheduler{2};
+  scheduler.schedule_and_wait(tasks);
+  EXPECT_EQ(scan_2->get_output()->row_count(), 10u);
+
+  // Operators that were executed already get no task
+  auto scan_3 = std::make_shared<TableScan>(scan_2, ColumnID{0}, ScanType::OpEquals, 25);
+  const auto more_tasks = OperatorTask::make_tasks_from_operator(scan_3);
+  ASSERT_EQ(more_tasks.size(), 1u);
+  scheduler.schedule_and_wait(more_tasks);
+  EXPECT_EQ(scan_3->get_output()->row_count(), 1u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,79 @@
+#include <memory>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/bit_packed_attribute_vector.hpp"
+
+namespace opossum {
+
+class StorageBitPackedAttributeVectorTest : public BaseTest {};
+
+TEST_F(StorageBitPackedAttributeVectorTest, FixedSize) {
+  BitPackedAttributeVector attribute_vector(10, 3);
+  EXPECT_EQ(attribute_vector.size(), 10u);
+}
+
+TEST_F(StorageBitPackedAttributeVectorTest, StoringValuesOfAllWidths) {
+  for (uint8_t bit_width = 1; bit_width <= 32; ++bit_width) {
+    const auto max_value_id = static_cast<uint32_t>((uint64_t{1} << bit_width) - 1);
+    BitPackedAttributeVector attribute_vector(100, bit_width);
+    for (uint32_t i = 0; i < 100; ++i) {
+      attribute_vector.set(i, ValueID{(i * 7919u) & max_value_id});
+    }
+    // Overwriting a value must not touch its neighbors
+    attribute_vector.set(50, ValueID{max_value_id});
+    attribute_vector.set(50, ValueID{0});
+
+    for (uint32_t i = 0; i < 100; ++i) {
+      const auto expected = i == 50 ? 0u : (i * 7919u) & max_value_id;
+      EXPECT_EQ(attribute_vector.get(i), expected) << "bit width " << static_cast<int>(bit_width);
+    }
+  }
+}
+
+TEST_F(StorageBitPackedAttributeVectorTest, Decode) {
+  BitPackedAttributeVector attribute_vector(70, 9);
+  for (uint32_t i = 0; i < 70; ++i) {
+    attribute_vector.set(i, ValueID{i * 7});
+  }
+
+  std::vector<uint32_t> codes(65);
+  attribute_vector.decode(3, 65, codes.data());
+  for (uint32_t i = 0; i < 65; ++i) {
+    EXPECT_EQ(codes[i], (i + 3) * 7);
+  }
+}
+
+TEST_F(StorageBitPackedAttributeVectorTest, TestsValueIDRange) {
+  BitPackedAttributeVector attribute_vector(1, 9);
+  attribute_vector.set(0, ValueID{511});
+  EXPECT_THROW(attribute_vector.set(0, ValueID{512}), std::logic_error);
+}
+
+TEST_F(StorageBitPackedAttributeVectorTest, ReferencedWordsAreReadOnly) {
+  BitPackedAttributeVector owning_vector(10, 5);
+  owning_vector.set(3, ValueID{17});
+  const auto owner = std::make_shared<int>();
+  BitPackedAttributeVector attribute_vector(10, 5, owning_vector.words(), owner);
+  EXPECT_EQ(attribute_vector.get(3), ValueID{17});
+  EXPECT_THROW(attribute_vector.set(3, ValueID{1}), std::logic_error);
+}
+
+TEST_F(StorageBitPackedAttributeVectorTest, Width) {
+  EXPECT_EQ(BitPackedAttributeVector(1, 1).width(), 1u);
+  EXPECT_EQ(BitPackedAttributeVector(1, 9).width(), 2u);
+  EXPECT_EQ(BitPackedAttributeVector(1, 9).bit_width(), 9u);
+  EXPECT_EQ(BitPackedAttributeVector(1, 17).width(), 3u);
+}
+
+TEST_F(StorageBitPackedAttributeVectorTest, RequiredBitWidth) {
+  EXPECT_EQ(BitPackedAttributeVector::required_bit_width(0), 1u);
+  EXPECT_EQ(BitPackedAttributeVector::required_bit_width(1), 1u);
+  EXPECT_EQ(BitPackedAttributeVector::required_bit_width(2), 2u);
+  EXPECT_EQ(BitPackedAttributeVector::required_bit_width(299), 9u);
+  EXPECT_EQ(BitPackedAttributeVector::required_bit_width(0xFFFFFFFF), 32u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,60 @@
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/bloom_filter.hpp"
+
+namespace opossum {
+
+class StorageBloomFilterTest : public BaseTest {};
+
+TEST_F(StorageBloomFilterTest, NoFalseNegatives) {
+  BloomFilter filter{10'000};
+  for (int value = 0; value < 10'000; ++value) filter.insert(value * 3);
+  for (int value = 0; value < 10'000; ++value) EXPECT_TRUE(filter.may_contain(value * 3));
+}
+
+TEST_F(StorageBloomFilterTest, FewFalsePositives) {
+  BloomFilter filter{10'000};
+  for (int value = 0; value < 10'000; ++value) filter.insert(value);
+
+  auto false_positives = 0;
+  for (int value = 10'000; value < 110'000; ++value) false_positives += filter.may_contain(value);
+  EXPECT_LT(false_positives, 2'000);
+}
+
+TEST_F(StorageBloomFilterTest, StringsAndStringViewsHashAlike) {
+  BloomFilter filter{100};
+  filter.insert(std::string_view{"Hasso"});
+  EXPECT_TRUE(filter.may_contain(std::string{"Hasso"}));
+}
+
+TEST_F(StorageBloomFilterTest, HashDoesNotDependOnTheStandardLibrary) {
+  // The bits are written to disk, so they must be the same for every build
+  BloomFilter filter{0};
+  filter.insert(42);
+  filter.insert(0.5);
+  filter.insert(std::string{"Hasso"});
+  const auto expected_words = std::vector<uint64_t>{0x0000802001000800ULL, 0x0000040400000000ULL,
+                                                    0x0002000000000000ULL, 0x2100020000000000ULL,
+                                                    0x0000000000000000ULL, 0x0000000000400081ULL,
+                                                    0x0800000080080000ULL, 0x0000000004040000ULL};
+  EXPECT_EQ(filter.words(), expected_words);
+}
+
+TEST_F(StorageBloomFilterTest, ZerosHashAlike) {
+  BloomFilter filter{100};
+  filter.insert(-0.0);
+  EXPECT_TRUE(filter.may_contain(0.0));
+}
+
+TEST_F(StorageBloomFilterTest, Size) {
+  // One cache line for every 51 values
+  EXPECT_EQ(BloomFilter{0}.byte_count(), 64u);
+  EXPECT_EQ(BloomFilter{1'000}.byte_count(), 20u * 64u);
+}
+
+}  // namespace opossum
@@ -6,6 +6,8 @@
 #include "../lib/resolve_type.hpp"
 #include "../lib/storage/base_segment.hpp"
 #include "../lib/storage/chunk.hpp"
+#include "../lib/storage/reference_segment.hpp"
+#include "../lib/storage/table.hpp"
 #include "../lib/types.hpp"
 
 namespace opossum {
@@ -58,6 +60,32 @@ TEST_F(StorageChunkTest, RetrieveSegment) {
   EXPECT_EQ(base_segment->size(), 4u);
 }
 
+TEST_F(StorageChunkTest, EstimateMemoryUsage) {
+  c.add_segment(int_value_segment);
+  c.add_segment(string_value_segment);
+  EXPECT_GT(c.estimate_memory_usage(),
+            int_value_segment->estimate_memory_usage() + string_value_segment->estimate_memory_usage());
+}
+
+TEST_F(StorageChunkTest, EstimateMemoryUsageCountsSharedPositionsOnce) {
+  auto table = std::make_shared<Table>();
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+  table->append({4, "Hello,"});
+
+  auto pos_list = std::make_shared<PosList>(1000, RowID{ChunkID{0}, 0});
+  auto reference_segment_a = std::make_shared<ReferenceSegment>(table, ColumnID{0}, pos_list);
+  auto reference_segment_b = std::make_shared<ReferenceSegment>(table, ColumnID{1}, pos_list);
+  c.add_segment(reference_segment_a);
+  c.add_segment(reference_segment_b);
+
+  const auto segment_bytes =
+      reference_segment_a->estimate_memory_usage() + reference_segment_b->estimate_memory_usage();
+  EXPECT_GE(reference_segment_a->estimate_positions_memory_usage(), 1000 * sizeof(RowID));
+  EXPECT_LT(c.estimate_memory_usage(), segment_bytes);
+  EXPECT_GT(c.estimate_memory_usage(), segment_bytes - reference_segment_b->estimate_positions_memory_usage());
+}
+
 TEST_F(StorageChunkTest, UnknownSegmentType) {
   // Exception will only be thrown in debug builds
   if (IS_DEBUG) {
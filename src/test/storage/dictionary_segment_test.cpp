@@ -7,6 +7,7 @@
 #include "../../lib/storage/base_segment.hpp"
 #include "../../lib/storage/dictionary_segment.hpp"
 #include "../../lib/storage/value_segment.hpp"
+#include "../../lib/utils/query_arena.hpp"
 
 class StorageDictionarySegmentTest : public ::testing::Test {
  protected:
@@ -75,3 +76,93 @@ TEST_F(StorageDictionarySegmentTest, Append) {
 
   EXPECT_THROW({ dict_col->append("Hasso"); }, std::runtime_error);
 }
+
+TEST_F(StorageDictionarySegmentTest, ChoosesSmallestAttributeVector) {
+  for (int i = 0; i < 200; ++i) vc_int->append(i);
+  auto col = opossum::make_shared_by_data_type<opossum::BaseSegment, opossum::DictionarySegment>("int", vc_int);
+  auto dict_col = std::dynamic_pointer_cast<opossum::DictionarySegment<int>>(col);
+
+  // 200 value ids need exactly 8 bits
+  EXPECT_NE(std::dynamic_pointer_cast<const opossum::FittedAttributeVector<uint8_t>>(dict_col->attribute_vector()),
+            nullptr);
+
+  for (int i = 200; i < 300; ++i) vc_int->append(i);
+  col = opossum::make_shared_by_data_type<opossum::BaseSegment, opossum::DictionarySegment>("int", vc_int);
+  dict_col = std::dynamic_pointer_cast<opossum::DictionarySegment<int>>(col);
+
+  // 300 value ids need 9 bits, which is less than the 16 bits of the next fitted width
+  const auto bit_packed_vector =
+      std::dynamic_pointer_cast<const opossum::BitPackedAttributeVector>(dict_col->attribute_vector());
+  ASSERT_NE(bit_packed_vector, nullptr);
+  EXPECT_EQ(bit_packed_vector->bit_width(), 9u);
+  EXPECT_EQ(dict_col->get(299), 299);
+}
+
+TEST_F(StorageDictionarySegmentTest, FrontCodedDictionary) {
+  for (int i = 0; i < 100; ++i) vc_str->append("https://example.com/path/" + std::to_string(1000 + (i * 37) % 50));
+  auto col = opossum::make_shared_by_data_type<opossum::BaseSegment, opossum::DictionarySegment>(
+      "string", vc_str, opossum::DictionaryFormat::FrontCoded);
+  auto dict_col = std::dynamic_pointer_cast<opossum::DictionarySegment<std::string>>(col);
+
+  EXPECT_EQ(dict_col->dictionary(), nullptr);
+  ASSERT_NE(dict_col->front_coded_dictionary(), nullptr);
+  EXPECT_EQ(dict_col->unique_values_count(), 50u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(dict_col->get(i), "https://example.com/path/" + std::to_string(1000 + (i * 37) % 50));
+  }
+
+  EXPECT_EQ(dict_col->value_by_value_id(opossum::ValueID{17}), "https://example.com/path/1017");
+  EXPECT_EQ(dict_col->lower_bound(std::string{"https://example.com/path/1017"}), opossum::ValueID{17});
+  EXPECT_EQ(dict_col->upper_bound(std::string{"https://example.com/path/1017"}), opossum::ValueID{18});
+  EXPECT_EQ(dict_col->lower_bound(std::string{"https://example.com/path/1017a"}), opossum::ValueID{18});
+  EXPECT_EQ(dict_col->upper_bound(std::string{"https://example.com/path/1049"}), opossum::INVALID_VALUE_ID);
+}
+
+TEST_F(StorageDictionarySegmentTest, FrontCodingIsIgnoredForOtherTypes) {
+  for (int i = 0; i < 10; ++i) vc_int->append(i);
+  auto dict_col = opossum::DictionarySegment<int>(vc_int, opossum::DictionaryFormat::FrontCoded);
+  EXPECT_NE(dict_col.dictionary(), nullptr);
+  EXPECT_EQ(dict_col.front_coded_dictionary(), nullptr);
+}
+
+TEST_F(StorageDictionarySegmentTest, MembershipFilter) {
+  for (int i = 0; i < 100; ++i) vc_int->append(i);
+  EXPECT_EQ(opossum::DictionarySegment<int>(vc_int).membership_filter(), nullptr);
+
+  for (int i = 100; i < 1000; ++i) vc_int->append(i * 2);
+  const auto dict_col = opossum::DictionarySegment<int>(vc_int);
+  const auto membership_filter = dict_col.membership_filter();
+  ASSERT_NE(membership_filter, nullptr);
+  for (int i = 100; i < 1000; ++i) EXPECT_TRUE(membership_filter->may_contain(i * 2));
+}
+
+TEST_F(StorageDictionarySegmentTest, EstimateMemoryUsage) {
+  for (int i = 0; i < 1000; ++i) vc_int->append(i % 10);
+  auto dict_col = std::make_shared<opossum::DictionarySegment<int>>(vc_int);
+
+  // The value segment stores 1000 ints, the dictionary segment 10 ints and 1000 four bit codes
+  EXPECT_GE(vc_int->estimate_memory_usage(), 1000 * sizeof(int));
+  EXPECT_GE(dict_col->estimate_memory_usage(), 10 * sizeof(int) + 500);
+  EXPECT_LT(dict_col->estimate_memory_usage(), 1000u);
+}
+
+TEST_F(StorageDictionarySegmentTest, MemoryResource) {
+  // 200 value ids fit a FittedAttributeVector<uint8_t> exactly
+  for (int i = 0; i < 1000; ++i) vc_int->append(i % 200);
+  for (int i = 0; i < 1000; ++i) vc_str->append(std::to_string(i % 300));
+
+  opossum::QueryArena memory_resource;
+  auto int_col = std::make_shared<opossum::DictionarySegment<int>>(vc_int, opossum::DictionaryFormat::Plain,
+                                                                   &memory_resource);
+  auto str_col = std::make_shared<opossum::DictionarySegment<std::string>>(vc_str, opossum::DictionaryFormat::Plain,
+                                                                           &memory_resource);
+  EXPECT_EQ(int_col->dictionary()->get_allocator().resource(), &memory_resource);
+  EXPECT_EQ(str_col->dictionary()->get_allocator().resource(), &memory_resource);
+  EXPECT_EQ(str_col->get(299), "299");
+
+  const auto fitted_vector =
+      std::dynamic_pointer_cast<const opossum::FittedAttributeVector<uint8_t>>(int_col->attribute_vector());
+  ASSERT_NE(fitted_vector, nullptr);
+  // The arena holds the two dictionaries and the 1000 value ids of the int segment, among others
+  EXPECT_GE(memory_resource.allocated_bytes(), 200 * sizeof(int) + 1000 + str_col->dictionary()->byte_count());
+}
@@ -1,3 +1,6 @@
+#include <memory>
+#include <vector>
+
 #include "../base_test.hpp"
 #include "gtest/gtest.h"
 
@@ -52,4 +55,19 @@ TEST_F(StorageFittedAttributeVectorTest, RetrieveIndices) {
   EXPECT_EQ(indices[7], 107u);
 }
 
+TEST_F(StorageFittedAttributeVectorTest, ReferencedIndices) {
+  const auto indices = std::vector<uint16_t>{3, 1, 4, 1, 5};
+  const auto owner = std::make_shared<int>();
+  FittedAttributeVector<uint16_t> attribute_vector(indices.data(), indices.size(), owner);
+  EXPECT_EQ(attribute_vector.size(), 5u);
+  EXPECT_EQ(attribute_vector.data(), indices.data());
+  EXPECT_EQ(attribute_vector.get(4), ValueID{5});
+  EXPECT_EQ(owner.use_count(), 2);
+
+  // The value ids are read-only, e.g., because they are mapped from a file
+  EXPECT_THROW(attribute_vector.set(0, ValueID{2}), std::logic_error);
+  EXPECT_THROW(attribute_vector.indices(), std::logic_error);
+  EXPECT_EQ(attribute_vector.get(0), ValueID{3});
+}
+
 }  // namespace opossum
@@ -0,0 +1,76 @@
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "resolve_type.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageFrameOfReferenceSegmentTest : public BaseTest {
+ protected:
+  std::shared_ptr<ValueSegment<int>> vc_int = std::make_shared<ValueSegment<int>>();
+  std::shared_ptr<ValueSegment<int64_t>> vc_long = std::make_shared<ValueSegment<int64_t>>();
+};
+
+TEST_F(StorageFrameOfReferenceSegmentTest, CompressSegmentInt) {
+  for (int i = 0; i < 10; ++i) vc_int->append(1000 - i * 3);
+
+  auto col = make_shared_by_data_type<BaseSegment, FrameOfReferenceSegment>("int", vc_int);
+  auto for_col = std::dynamic_pointer_cast<FrameOfReferenceSegment<int>>(col);
+
+  EXPECT_EQ(for_col->size(), 10u);
+  EXPECT_EQ(for_col->minimum(), 973);
+  // The largest offset is 27, which fits into 5 bits
+  EXPECT_EQ(for_col->offsets()->bit_width(), 5u);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(for_col->get(i), 1000 - i * 3);
+  }
+  EXPECT_EQ((*for_col)[9], AllTypeVariant{973});
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, FullIntRange) {
+  vc_int->append(std::numeric_limits<int>::min());
+  vc_int->append(std::numeric_limits<int>::max());
+  vc_int->append(0);
+  auto for_col = FrameOfReferenceSegment<int>(vc_int);
+
+  EXPECT_EQ(for_col.offsets()->bit_width(), 32u);
+  EXPECT_EQ(for_col.get(0), std::numeric_limits<int>::min());
+  EXPECT_EQ(for_col.get(1), std::numeric_limits<int>::max());
+  EXPECT_EQ(for_col.get(2), 0);
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, NegativeLongs) {
+  vc_long->append(int64_t{-5'000'000'000});
+  vc_long->append(int64_t{-5'000'000'001});
+  auto for_col = FrameOfReferenceSegment<int64_t>(vc_long);
+
+  EXPECT_EQ(for_col.offsets()->bit_width(), 1u);
+  EXPECT_EQ(for_col.get(0), int64_t{-5'000'000'000});
+  EXPECT_EQ(for_col.get(1), int64_t{-5'000'000'001});
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, RangeTooLarge) {
+  vc_long->append(int64_t{0});
+  vc_long->append(int64_t{1} << 32);
+  EXPECT_THROW(FrameOfReferenceSegment<int64_t>{vc_long}, std::logic_error);
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, OnlyIntegralTypes) {
+  auto vc_str = std::make_shared<ValueSegment<std::string>>();
+  vc_str->append("Bill");
+  EXPECT_THROW(FrameOfReferenceSegment<std::string>{vc_str}, std::logic_error);
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, Append) {
+  auto for_col = FrameOfReferenceSegment<int>(vc_int);
+  EXPECT_EQ(for_col.size(), 0u);
+  EXPECT_THROW(for_col.append(1), std::runtime_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/front_coded_dictionary.hpp"
+#include "storage/string_heap.hpp"
+
+namespace opossum {
+
+class StorageFrontCodedDictionaryTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Sorted, unique paths with long shared prefixes, spanning several blocks. One path exceeds 127 characters, so
+    // that its length needs more than one byte.
+    for (int i = 0; i < 100; ++i) {
+      const auto directory = "/home/user/projects/" + std::to_string(100 + i / 10);
+      values.emplace_back(directory + "/src/file_" + std::to_string(i % 10));
+    }
+    values.emplace_back("/home/user/projects/200/" + std::string(200, 'x'));
+    values.emplace_back("/var");
+    std::sort(values.begin(), values.end());
+    for (const auto& value : values) heap.emplace_back(value);
+  }
+
+  std::vector<std::string> values;
+  StringHeap heap;
+};
+
+TEST_F(StorageFrontCodedDictionaryTest, DecodesAllValues) {
+  const FrontCodedDictionary dictionary{heap};
+  ASSERT_EQ(dictionary.size(), values.size());
+  for (size_t index = 0; index < values.size(); ++index) {
+    EXPECT_EQ(dictionary.get(index), values[index]);
+  }
+}
+
+TEST_F(StorageFrontCodedDictionaryTest, SharedPrefixesAreStoredOnce) {
+  const FrontCodedDictionary dictionary{heap};
+  EXPECT_LT(dictionary.byte_count(), heap.byte_count() / 3);
+}
+
+TEST_F(StorageFrontCodedDictionaryTest, LowerAndUpperBound) {
+  const FrontCodedDictionary dictionary{heap};
+
+  // Search for every value, and for strings directly before and after each value
+  const auto expect_bounds = [&](const std::string& search_value) {
+    const auto lower = std::lower_bound(values.begin(), values.end(), search_value) - values.begin();
+    const auto upper = std::upper_bound(values.begin(), values.end(), search_value) - values.begin();
+    EXPECT_EQ(dictionary.lower_bound(search_value), static_cast<size_t>(lower)) << search_value;
+    EXPECT_EQ(dictionary.upper_bound(search_value), static_cast<size_t>(upper)) << search_value;
+  };
+  for (const auto& value : values) {
+    expect_bounds(value);
+    expect_bounds(value + '\0');
+    expect_bounds(value.substr(0, value.size() - 1));
+  }
+
+  EXPECT_EQ(dictionary.lower_bound(""), 0u);
+  EXPECT_EQ(dictionary.upper_bound("/zzz"), values.size());
+}
+
+TEST_F(StorageFrontCodedDictionaryTest, EmptyDictionary) {
+  const FrontCodedDictionary dictionary{StringHeap{}};
+  EXPECT_EQ(dictionary.size(), 0u);
+  EXPECT_EQ(dictionary.lower_bound("a"), 0u);
+  EXPECT_EQ(dictionary.upper_bound("a"), 0u);
+}
+
+}  // namespace opossum
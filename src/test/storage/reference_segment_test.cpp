@@ -93,4 +93,31 @@ TEST_F(ReferenceSegmentTest, RetrievesValuesFromChunks) {
   EXPECT_EQ(reference_segment[2], column_2[1]);
 }
 
+TEST_F(ReferenceSegmentTest, RetrievesValuesFromRowIDBitmap) {
+  auto row_id_bitmap = std::make_shared<RowIDBitmap>();
+  row_id_bitmap->push_back(RowID{ChunkID{0}, 1});
+  row_id_bitmap->push_back(RowID{ChunkID{1}, 0});
+  auto reference_segment = ReferenceSegment(_test_table, ColumnID{0}, row_id_bitmap);
+
+  EXPECT_EQ(reference_segment.size(), 2u);
+  EXPECT_EQ(reference_segment.pos_list(), nullptr);
+  EXPECT_EQ(reference_segment[0], AllTypeVariant{1234});
+  EXPECT_EQ(reference_segment[1], AllTypeVariant{54321});
+
+  PosList row_ids;
+  reference_segment.for_each_row_id([&](const RowID& row_id) { row_ids.emplace_back(row_id); });
+  EXPECT_EQ(row_ids, (PosList{{ChunkID{0}, 1}, {ChunkID{1}, 0}}));
+}
+
+TEST_F(ReferenceSegmentTest, ReferencesSingleChunk) {
+  auto pos_list = std::make_shared<PosList>(std::initializer_list<RowID>({RowID{ChunkID{1}, 1}, RowID{ChunkID{1}, 0}}));
+  EXPECT_FALSE(ReferenceSegment(_test_table, ColumnID{0}, pos_list).references_single_chunk());
+  EXPECT_TRUE(ReferenceSegment(_test_table, ColumnID{0}, pos_list, true).references_single_chunk());
+
+  if (IS_DEBUG) {
+    pos_list->emplace_back(RowID{ChunkID{0}, 0});
+    EXPECT_THROW(ReferenceSegment(_test_table, ColumnID{0}, pos_list, true), std::logic_error);
+  }
+}
+
 }  // namespace opossum
@@ -0,0 +1,81 @@
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/row_id_bitmap.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class StorageRowIDBitmapTest : public BaseTest {
+ protected:
+  static PosList collect(const RowIDBitmap& bitmap) {
+    PosList pos_list;
+    bitmap.for_each([&](const RowID& row_id) { pos_list.emplace_back(row_id); });
+    return pos_list;
+  }
+};
+
+TEST_F(StorageRowIDBitmapTest, EmptyBitmap) {
+  RowIDBitmap bitmap;
+  EXPECT_TRUE(bitmap.empty());
+  EXPECT_EQ(bitmap.size(), 0u);
+  EXPECT_TRUE(collect(bitmap).empty());
+}
+
+TEST_F(StorageRowIDBitmapTest, SparseContainers) {
+  // Positions in different chunks and in different containers of the same chunk
+  const auto expected = PosList{{ChunkID{0}, 3}, {ChunkID{0}, 70'000}, {ChunkID{2}, 0}, {ChunkID{2}, 65'535}};
+  RowIDBitmap bitmap;
+  for (const auto& row_id : expected) bitmap.push_back(row_id);
+
+  EXPECT_EQ(bitmap.size(), 4u);
+  EXPECT_EQ(collect(bitmap), expected);
+  EXPECT_EQ(bitmap.to_pos_list(), expected);
+  for (size_t index = 0; index < expected.size(); ++index) {
+    EXPECT_EQ(bitmap[index], expected[index]);
+  }
+}
+
+TEST_F(StorageRowIDBitmapTest, DenseContainers) {
+  // Every third row of two chunks turns both containers into bitmaps
+  PosList expected;
+  RowIDBitmap bitmap;
+  for (const auto& chunk_id : {ChunkID{1}, ChunkID{4}}) {
+    for (ChunkOffset offset{5}; offset < 60'000; offset += 3) {
+      expected.emplace_back(RowID{chunk_id, offset});
+      bitmap.push_back(RowID{chunk_id, offset});
+    }
+  }
+
+  EXPECT_EQ(bitmap.size(), expected.size());
+  EXPECT_EQ(collect(bitmap), expected);
+  EXPECT_EQ(bitmap[0], expected[0]);
+  EXPECT_EQ(bitmap[12'345], expected[12'345]);
+  EXPECT_EQ(bitmap[expected.size() - 1], expected.back());
+  for (size_t index = 0; index < expected.size(); index += 97) {
+    EXPECT_EQ(bitmap[index], expected[index]);
+  }
+
+  // 2 bitmaps of 8 KB instead of 40000 positions of 8 bytes
+  EXPECT_LT(bitmap.byte_count(), 20'000u);
+}
+
+TEST_F(StorageRowIDBitmapTest, RandomAccessSkipsEmptyBlocks) {
+  // Two dense ranges with thousands of empty words between them
+  PosList expected;
+  RowIDBitmap bitmap;
+  for (const auto begin : {ChunkOffset{100}, ChunkOffset{50'000}}) {
+    for (auto offset = begin; offset < begin + 5'000; ++offset) {
+      expected.emplace_back(RowID{ChunkID{0}, offset});
+      bitmap.push_back(RowID{ChunkID{0}, offset});
+    }
+  }
+
+  for (size_t index = 0; index < expected.size(); ++index) {
+    ASSERT_EQ(bitmap[index], expected[index]);
+  }
+}
+
+}  // namespace opossum
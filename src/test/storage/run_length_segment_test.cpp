@@ -0,0 +1,63 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "resolve_type.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageRunLengthSegmentTest : public BaseTest {
+ protected:
+  std::shared_ptr<ValueSegment<int>> vc_int = std::make_shared<ValueSegment<int>>();
+  std::shared_ptr<ValueSegment<std::string>> vc_str = std::make_shared<ValueSegment<std::string>>();
+};
+
+TEST_F(StorageRunLengthSegmentTest, CompressSegmentString) {
+  vc_str->append("Bill");
+  vc_str->append("Bill");
+  vc_str->append("Steve");
+  vc_str->append("Alexander");
+  vc_str->append("Alexander");
+  vc_str->append("Alexander");
+  vc_str->append("Bill");
+
+  auto col = make_shared_by_data_type<BaseSegment, RunLengthSegment>("string", vc_str);
+  auto rle_col = std::dynamic_pointer_cast<RunLengthSegment<std::string>>(col);
+
+  EXPECT_EQ(rle_col->size(), 7u);
+  EXPECT_EQ(rle_col->values(), (std::vector<std::string>{"Bill", "Steve", "Alexander", "Bill"}));
+  EXPECT_EQ(rle_col->end_positions(), (std::vector<ChunkOffset>{2, 3, 6, 7}));
+
+  EXPECT_EQ(rle_col->get(0), "Bill");
+  EXPECT_EQ(rle_col->get(1), "Bill");
+  EXPECT_EQ(rle_col->get(2), "Steve");
+  EXPECT_EQ(rle_col->get(5), "Alexander");
+  EXPECT_EQ((*rle_col)[6], AllTypeVariant{"Bill"});
+}
+
+TEST_F(StorageRunLengthSegmentTest, EmptySegment) {
+  auto rle_col = RunLengthSegment<int>(vc_int);
+  EXPECT_EQ(rle_col.size(), 0u);
+  EXPECT_TRUE(rle_col.values().empty());
+}
+
+TEST_F(StorageRunLengthSegmentTest, SingleRun) {
+  for (int i = 0; i < 100; ++i) vc_int->append(42);
+  auto rle_col = RunLengthSegment<int>(vc_int);
+
+  EXPECT_EQ(rle_col.size(), 100u);
+  EXPECT_EQ(rle_col.values().size(), 1u);
+  EXPECT_EQ(rle_col.get(99), 42);
+}
+
+TEST_F(StorageRunLengthSegmentTest, Append) {
+  auto rle_col = RunLengthSegment<int>(vc_int);
+  EXPECT_THROW(rle_col.append(1), std::runtime_error);
+}
+
+}  // namespace opossum
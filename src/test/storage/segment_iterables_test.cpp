@@ -0,0 +1,188 @@
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/storage/segment_iterables.hpp"
+#include "../lib/storage/table.hpp"
+#include "../lib/type_cast.hpp"
+
+namespace opossum {
+
+class StorageSegmentIterablesTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(10);
+    _table->add_column("a", "int");
+    _table->add_column("b", "string");
+    for (int i = 0; i < 45; ++i) _table->append({i % 4 * 100 + i, "value " + std::to_string(i % 3)});
+
+    _table->compress_chunk(ChunkID{0}, EncodingType::Dictionary);
+    _table->compress_chunk(ChunkID{1}, {EncodingType::RunLength, EncodingType::RunLength});
+    _table->compress_chunk(ChunkID{2}, {EncodingType::FrameOfReference, EncodingType::FrontCodedDictionary});
+  }
+
+  // collects the values of a segment using segment_for_each and checks that the positions are passed in order
+  template <typename T>
+  static std::vector<T> _materialize(const BaseSegment& segment) {
+    std::vector<T> values;
+    segment_for_each<T>(segment, [&](const auto& value, const ChunkOffset offset) {
+      EXPECT_EQ(offset, values.size());
+      values.emplace_back(value);
+    });
+    return values;
+  }
+
+  // collects the values of a segment using operator[]
+  template <typename T>
+  static std::vector<T> _materialize_slowly(const BaseSegment& segment) {
+    std::vector<T> values;
+    for (size_t offset = 0; offset < segment.size(); ++offset) values.emplace_back(type_cast<T>(segment[offset]));
+    return values;
+  }
+
+  template <typename Value>
+  static AllTypeVariant _to_variant(const Value& value) {
+    if constexpr (std::is_same_v<Value, std::string_view>) {
+      return std::string{value};
+    } else {
+      return value;
+    }
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(StorageSegmentIterablesTest, ResolveSegmentType) {
+  auto segment_types = std::vector<std::string>{};
+  for (ChunkID chunk_id{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    resolve_segment_type<int32_t>(*_table->get_chunk(chunk_id).get_segment(ColumnID{0}), [&](const auto& segment) {
+      using SegmentType = std::decay_t<decltype(segment)>;
+      if constexpr (std::is_same_v<SegmentType, ValueSegment<int32_t>>) {
+        segment_types.emplace_back("Value");
+      } else if constexpr (std::is_same_v<SegmentType, DictionarySegment<int32_t>>) {
+        segment_types.emplace_back("Dictionary");
+      } else if constexpr (std::is_same_v<SegmentType, RunLengthSegment<int32_t>>) {
+        segment_types.emplace_back("RunLength");
+      } else if constexpr (std::is_same_v<SegmentType, FrameOfReferenceSegment<int32_t>>) {
+        segment_types.emplace_back("FrameOfReference");
+      } else {
+        segment_types.emplace_back("Reference");
+      }
+    });
+  }
+  EXPECT_EQ(segment_types, (std::vector<std::string>{"Dictionary", "RunLength", "FrameOfReference", "Value", "Value"}));
+
+  const auto value_segment = ValueSegment<float>{};
+  EXPECT_THROW(resolve_segment_type<int32_t>(value_segment, [](const auto&) {}), std::logic_error);
+}
+
+TEST_F(StorageSegmentIterablesTest, ForEach) {
+  for (ChunkID chunk_id{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    const auto& chunk = _table->get_chunk(chunk_id);
+    EXPECT_EQ(_materialize<int32_t>(*chunk.get_segment(ColumnID{0})),
+              _materialize_slowly<int32_t>(*chunk.get_segment(ColumnID{0})));
+    EXPECT_EQ(_materialize<std::string>(*chunk.get_segment(ColumnID{1})),
+              _materialize_slowly<std::string>(*chunk.get_segment(ColumnID{1})));
+  }
+
+  // The string type of a column can be given at runtime
+  auto value_count = size_t{0};
+  segment_for_each("string", *_table->get_chunk(ChunkID{0}).get_segment(ColumnID{1}),
+                   [&](const auto& value, const ChunkOffset) {
+                     // The functor is instantiated for all data types
+                     auto stream = std::ostringstream{};
+                     stream << value;
+                     EXPECT_EQ(stream.str().substr(0, 6), "value ");
+                     ++value_count;
+                   });
+  EXPECT_EQ(value_count, 10u);
+}
+
+TEST_F(StorageSegmentIterablesTest, ForEachAt) {
+  const auto offsets = std::vector<ChunkOffset>{7, 0, 3, 3, 9};
+  for (ChunkID chunk_id{0}; chunk_id < 4; ++chunk_id) {
+    const auto& segment = *_table->get_chunk(chunk_id).get_segment(ColumnID{0});
+    resolve_segment_type<int32_t>(segment, [&](const auto& typed_segment) {
+      if constexpr (!std::is_same_v<std::decay_t<decltype(typed_segment)>, ReferenceSegment>) {
+        auto index_count = size_t{0};
+        create_iterable(typed_segment).for_each_at(offsets.data(), offsets.size(), [&](const auto& value,
+                                                                                       const size_t index) {
+          EXPECT_EQ(index, index_count++);
+          EXPECT_EQ(value, type_cast<int32_t>(segment[offsets[index]]));
+        });
+        EXPECT_EQ(index_count, offsets.size());
+      }
+    });
+  }
+}
+
+TEST_F(StorageSegmentIterablesTest, ReferenceSegment) {
+  // Positions in any order, across segments of all types, including several batches of the same chunk
+  auto pos_list = std::make_shared<PosList>();
+  for (ChunkOffset offset{0}; offset < 5; ++offset) {
+    for (ChunkID chunk_id{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+      pos_list->emplace_back(RowID{ChunkID{_table->chunk_count() - 1 - chunk_id}, offset});
+    }
+  }
+  for (auto repetition = 0; repetition < 1000; ++repetition) pos_list->emplace_back(RowID{ChunkID{2}, 4});
+
+  for (ColumnID column_id{0}; column_id < 2; ++column_id) {
+    const auto segment = ReferenceSegment{_table, column_id, pos_list};
+    auto position_count = size_t{0};
+    segment_for_each(_table->column_type(column_id), segment, [&](const auto& value, const ChunkOffset position) {
+      EXPECT_EQ(position, position_count++);
+      EXPECT_EQ(_to_variant(value), segment[position]);
+    });
+    EXPECT_EQ(position_count, pos_list->size());
+  }
+}
+
+TEST_F(StorageSegmentIterablesTest, ReferenceSegmentWithBitmap) {
+  auto row_id_bitmap = std::make_shared<RowIDBitmap>();
+  for (ChunkID chunk_id{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    for (ChunkOffset offset{1}; offset < _table->get_chunk(chunk_id).size(); offset += 2) {
+      row_id_bitmap->push_back(RowID{chunk_id, offset});
+    }
+  }
+
+  const auto segment = ReferenceSegment{_table, ColumnID{0}, row_id_bitmap};
+  auto values = std::vector<int32_t>{};
+  ReferenceSegmentIterable<int32_t>{segment}.for_each_referenced([&](const int32_t value, const RowID& row_id) {
+    EXPECT_EQ(row_id.chunk_offset % 2, 1u);
+    values.emplace_back(value);
+  });
+  EXPECT_EQ(values.size(), 22u);
+  EXPECT_EQ(values, _materialize_slowly<int32_t>(segment));
+}
+
+TEST_F(StorageSegmentIterablesTest, ReferenceSegmentOfSingleChunk) {
+  // More positions than fit into a single batch
+  auto pos_list = std::make_shared<PosList>();
+  for (auto repetition = 0; repetition < 300; ++repetition) {
+    pos_list->emplace_back(RowID{ChunkID{1}, 9});
+    pos_list->emplace_back(RowID{ChunkID{1}, 2});
+  }
+
+  for (ColumnID column_id{0}; column_id < 2; ++column_id) {
+    const auto segment = ReferenceSegment{_table, column_id, pos_list, true};
+    auto position_count = size_t{0};
+    segment_for_each(_table->column_type(column_id), segment, [&](const auto& value, const ChunkOffset position) {
+      EXPECT_EQ(position, position_count++);
+      EXPECT_EQ(_to_variant(value), segment[position]);
+    });
+    EXPECT_EQ(position_count, pos_list->size());
+  }
+
+  auto row_ids = PosList{};
+  const auto empty_segment = ReferenceSegment{_table, ColumnID{0}, std::make_shared<PosList>(), true};
+  ReferenceSegmentIterable<int32_t>{empty_segment}.for_each_referenced(
+      [&](const int32_t, const RowID& row_id) { row_ids.emplace_back(row_id); });
+  EXPECT_TRUE(row_ids.empty());
+}
+
+}  // namespace opossum
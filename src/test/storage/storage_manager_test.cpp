@@ -1,4 +1,6 @@
+#include <filesystem>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -64,4 +66,51 @@ TEST_F(StorageStorageManagerTest, Print) {
   sm.print(std::cout);
 }
 
+TEST_F(StorageStorageManagerTest, PrintMemoryUsage) {
+  StorageManager::reset();
+  auto& sm = StorageManager::get();
+  auto table = std::make_shared<Table>(2);
+  table->add_column("a", "int");
+  for (auto value = int32_t{0}; value < 5; ++value) table->append({value});
+  table->compress_chunk(ChunkID{0});
+  sm.add_table("table", table);
+
+  auto stream = std::stringstream{};
+  sm.print(stream);
+  const auto output = stream.str();
+  EXPECT_NE(output.find("table\t1\t5\t3\t" + std::to_string(table->estimate_memory_usage()) + "\n"), std::string::npos);
+  EXPECT_NE(output.find("\ta\tint\tDictionary\t1\t"), std::string::npos);
+  EXPECT_NE(output.find("\ta\tint\tUnencoded\t2\t"), std::string::npos);
+}
+
+TEST_F(StorageStorageManagerTest, ExportImportTables) {
+  auto& sm = StorageManager::get();
+  auto table = std::make_shared<Table>(2);
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+  for (auto value = int32_t{0}; value < 5; ++value) table->append({value, std::to_string(value)});
+  table->compress_chunk(ChunkID{0});
+  sm.add_table("table with spaces", table);
+
+  const auto directory = std::filesystem::temp_directory_path() / "opossum_storage_manager_test";
+  sm.export_tables(directory);
+  StorageManager::reset();
+  StorageManager::get().import_tables(directory);
+
+  EXPECT_EQ(StorageManager::get().table_names().size(), 3u);
+  EXPECT_TABLE_EQ(StorageManager::get().get_table("table with spaces"), table, true);
+  EXPECT_EQ(StorageManager::get().get_table("second_table")->chunk_size(), 4u);
+
+  // Tables that exist already are not replaced
+  EXPECT_THROW(StorageManager::get().import_tables(directory), std::exception);
+
+  // Exporting into the directory of imported tables replaces their files, which stay mapped until the tables are gone
+  const auto imported_table = StorageManager::get().get_table("table with spaces");
+  StorageManager::reset();
+  for (const auto* const name : {"a", "b", "c"}) StorageManager::get().add_table(name, std::make_shared<Table>());
+  StorageManager::get().export_tables(directory);
+  EXPECT_TABLE_EQ(imported_table, table, true);
+  std::filesystem::remove_all(directory);
+}
+
 }  // namespace opossum
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/string_heap.hpp"
+
+namespace opossum {
+
+class StorageStringHeapTest : public BaseTest {};
+
+TEST_F(StorageStringHeapTest, EmptyHeap) {
+  StringHeap heap;
+  EXPECT_EQ(heap.size(), 0u);
+  EXPECT_TRUE(heap.empty());
+  EXPECT_EQ(heap.begin(), heap.end());
+}
+
+TEST_F(StorageStringHeapTest, StoresStringsBackToBack) {
+  StringHeap heap;
+  heap.emplace_back("Hello");
+  heap.emplace_back("");
+  heap.emplace_back(std::string(100, 'x'));
+  heap.push_back("World");
+
+  EXPECT_EQ(heap.size(), 4u);
+  EXPECT_FALSE(heap.empty());
+  EXPECT_EQ(heap.byte_count(), 110u);
+  EXPECT_EQ(heap[0], "Hello");
+  EXPECT_EQ(heap[1], "");
+  EXPECT_EQ(heap[2], std::string(100, 'x'));
+  EXPECT_EQ(heap[3], "World");
+  EXPECT_EQ(heap.back(), "World");
+}
+
+TEST_F(StorageStringHeapTest, Iterators) {
+  const StringHeap heap{"Alexander", "Bill", "Hasso", "Steve"};
+  EXPECT_EQ(heap.end() - heap.begin(), 4);
+  EXPECT_EQ(*(heap.begin() + 2), "Hasso");
+  EXPECT_EQ(heap.begin()[3], "Steve");
+
+  // Iterators work with the standard algorithms used on sorted dictionaries
+  EXPECT_EQ(std::lower_bound(heap.begin(), heap.end(), std::string{"Bob"}) - heap.begin(), 2);
+  EXPECT_EQ(std::upper_bound(heap.begin(), heap.end(), std::string{"Bill"}) - heap.begin(), 2);
+  EXPECT_EQ(std::lower_bound(heap.begin(), heap.end(), std::string{"Zoe"}), heap.end());
+}
+
+TEST_F(StorageStringHeapTest, Equality) {
+  EXPECT_EQ((StringHeap{"a", "bc"}), (StringHeap{"a", "bc"}));
+  EXPECT_NE((StringHeap{"a", "bc"}), (StringHeap{"ab", "c"}));
+}
+
+TEST_F(StorageStringHeapTest, AppendRange) {
+  auto heap = StringHeap{"x"};
+  const auto other = StringHeap{"a", "bc", "", "def"};
+  heap.append(other, 1, 3);
+  heap.append(other, 3, 3);
+  EXPECT_EQ(heap, (StringHeap{"x", "bc", ""}));
+  heap.append(other, 0, 4);
+  EXPECT_EQ(heap.size(), 7u);
+  EXPECT_EQ(heap[6], "def");
+  EXPECT_EQ(heap.byte_count(), 9u);
+}
+
+}  // namespace opossum
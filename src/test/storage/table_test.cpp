@@ -1,6 +1,10 @@
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <memory_resource>  // NOLINT(build/include_order)
+#include <new>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -9,7 +13,10 @@
 
 #include "../lib/resolve_type.hpp"
 #include "../lib/storage/dictionary_segment.hpp"
+#include "../lib/storage/frame_of_reference_segment.hpp"
+#include "../lib/storage/run_length_segment.hpp"
 #include "../lib/storage/table.hpp"
+#include "../lib/storage/zone_map.hpp"
 
 namespace opossum {
 
@@ -97,6 +104,373 @@ TEST_F(StorageTableTest, CompressChunk) {
   EXPECT_NE(dynamic_cast<DictionarySegment<int>*>(first_segment.get()), nullptr);
 }
 
+TEST_F(StorageTableTest, CompressChunkRunLength) {
+  t.append({1, "Hello"});
+  t.append({1, "Hello"});
+  t.compress_chunk(ChunkID{0}, EncodingType::RunLength);
+  const auto& chunk = t.get_chunk(ChunkID{0});
+  const auto first_segment = std::dynamic_pointer_cast<RunLengthSegment<int>>(chunk.get_segment(ColumnID{0}));
+  ASSERT_NE(first_segment, nullptr);
+  EXPECT_EQ(first_segment->values().size(), 1u);
+  EXPECT_EQ(first_segment->size(), 2u);
+}
+
+TEST_F(StorageTableTest, CompressChunkFrameOfReference) {
+  Table int_table{2};
+  int_table.add_column("col_1", "int");
+  int_table.append({4});
+  int_table.append({-3});
+  int_table.compress_chunk(ChunkID{0}, EncodingType::FrameOfReference);
+  const auto& chunk = int_table.get_chunk(ChunkID{0});
+  const auto first_segment = std::dynamic_pointer_cast<FrameOfReferenceSegment<int>>(chunk.get_segment(ColumnID{0}));
+  ASSERT_NE(first_segment, nullptr);
+  EXPECT_EQ(first_segment->minimum(), -3);
+  EXPECT_EQ(first_segment->get(0), 4);
+
+  // Strings cannot be frame of reference encoded
+  t.append({1, "Hello"});
+  t.append({2, "World"});
+  EXPECT_THROW(t.compress_chunk(ChunkID{0}, EncodingType::FrameOfReference), std::logic_error);
+}
+
+TEST_F(StorageTableTest, BuildsZoneMaps) {
+  t.append({4, "Hello,"});
+  EXPECT_EQ(t.get_chunk(ChunkID{0}).get_zone_map(ColumnID{0}), nullptr);
+
+  // Zone maps are built once a chunk is full
+  t.append({6, "world"});
+  const auto zone_map =
+      std::dynamic_pointer_cast<const ZoneMap<int>>(t.get_chunk(ChunkID{0}).get_zone_map(ColumnID{0}));
+  ASSERT_NE(zone_map, nullptr);
+  EXPECT_EQ(zone_map->min(), 4);
+  EXPECT_EQ(zone_map->max(), 6);
+
+  // ... and kept when the chunk is compressed
+  t.compress_chunk(ChunkID{0});
+  EXPECT_EQ(t.get_chunk(ChunkID{0}).get_zone_map(ColumnID{0}), zone_map);
+
+  // Compressing a chunk that is not full yet builds them as well
+  t.append({3, "!"});
+  t.compress_chunk(ChunkID{1});
+  const auto string_zone_map =
+      std::dynamic_pointer_cast<const ZoneMap<std::string>>(t.get_chunk(ChunkID{1}).get_zone_map(ColumnID{1}));
+  ASSERT_NE(string_zone_map, nullptr);
+  EXPECT_EQ(string_zone_map->max(), "!");
+}
+
+TEST_F(StorageTableTest, CompressChunksInParallel) {
+  for (int i = 0; i < 100; ++i) t.append({i % 7, "value_" + std::to_string(i % 13)});
+
+  std::vector<std::thread> threads;
+  for (uint32_t thread_id = 0; thread_id < 4; ++thread_id) {
+    threads.emplace_back([&, thread_id] {
+      for (ChunkID chunk_id{thread_id}; chunk_id < t.chunk_count() - 1; chunk_id += 4) t.compress_chunk(chunk_id);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  for (ChunkID chunk_id{0}; chunk_id < 50; ++chunk_id) {
+    const auto& chunk = t.get_chunk(chunk_id);
+    const auto segment = chunk.get_segment(ColumnID{1});
+    const auto string_segment = std::dynamic_pointer_cast<DictionarySegment<std::string>>(segment);
+    ASSERT_NE(string_segment, nullptr);
+    for (ChunkOffset offset{0}; offset < 2; ++offset) {
+      const auto row = chunk_id * 2 + offset;
+      EXPECT_EQ(string_segment->get(offset), "value_" + std::to_string(row % 13));
+    }
+  }
+}
+
+TEST_F(StorageTableTest, CompressTable) {
+  for (int i = 0; i < 5; ++i) t.append({i, "value_" + std::to_string(i % 2)});
+  const auto zone_map = t.get_chunk(ChunkID{0}).get_zone_map(ColumnID{0});
+
+  const auto statistics = t.compress({EncodingType::RunLength, EncodingType::FrontCodedDictionary}, 4);
+
+  // All chunks are compressed, including the last one. A new chunk is created for subsequent appends.
+  ASSERT_EQ(statistics.size(), 3u);
+  EXPECT_EQ(t.chunk_count(), 4u);
+  for (ChunkID chunk_id{0}; chunk_id < 3; ++chunk_id) {
+    EXPECT_EQ(statistics[chunk_id].chunk_id, chunk_id);
+    EXPECT_GT(statistics[chunk_id].memory_usage_before, 0u);
+    EXPECT_GT(statistics[chunk_id].memory_usage_after, 0u);
+
+    const auto& chunk = t.get_chunk(chunk_id);
+    const auto int_segment = std::dynamic_pointer_cast<RunLengthSegment<int>>(chunk.get_segment(ColumnID{0}));
+    const auto string_segment =
+        std::dynamic_pointer_cast<DictionarySegment<std::string>>(chunk.get_segment(ColumnID{1}));
+    ASSERT_NE(int_segment, nullptr);
+    ASSERT_NE(string_segment, nullptr);
+    EXPECT_NE(string_segment->front_coded_dictionary(), nullptr);
+    for (ChunkOffset offset{0}; offset < chunk.size(); ++offset) {
+      const auto row = static_cast<int>(chunk_id * 2 + offset);
+      EXPECT_EQ(int_segment->get(offset), row);
+      EXPECT_EQ(string_segment->get(offset), "value_" + std::to_string(row % 2));
+    }
+  }
+
+  // Zone maps are kept or built
+  EXPECT_EQ(t.get_chunk(ChunkID{0}).get_zone_map(ColumnID{0}), zone_map);
+  EXPECT_NE(t.get_chunk(ChunkID{2}).get_zone_map(ColumnID{0}), nullptr);
+
+  t.append({5, "value_1"});
+  EXPECT_EQ(t.row_count(), 6u);
+
+  // Compressed chunks are skipped
+  EXPECT_EQ(t.compress({EncodingType::Dictionary, EncodingType::Dictionary}, 4).size(), 1u);
+  EXPECT_THROW(t.compress({EncodingType::Dictionary}), std::exception);
+}
+
+TEST_F(StorageTableTest, CompressTableAfterFailedEncoding) {
+  for (int i = 0; i < 5; ++i) t.append({i, "value_" + std::to_string(i)});
+
+  // Strings cannot be frame-of-reference encoded, so no chunk is replaced
+  EXPECT_THROW(t.compress({EncodingType::Dictionary, EncodingType::FrameOfReference}, 4), std::logic_error);
+  EXPECT_THROW(t.compress_chunk(ChunkID{0}, EncodingType::FrameOfReference), std::logic_error);
+  EXPECT_NE(std::dynamic_pointer_cast<ValueSegment<int>>(t.get_chunk(ChunkID{0}).get_segment(ColumnID{0})), nullptr);
+
+  // The failed chunks can be compressed again
+  t.compress_chunk(ChunkID{0});
+  EXPECT_NE(std::dynamic_pointer_cast<DictionarySegment<int>>(t.get_chunk(ChunkID{0}).get_segment(ColumnID{0})),
+            nullptr);
+  const auto statistics = t.compress({EncodingType::Dictionary, EncodingType::Dictionary}, 4);
+  ASSERT_EQ(statistics.size(), 2u);
+  EXPECT_EQ(statistics[0].chunk_id, ChunkID{1});
+  for (ChunkID chunk_id{0}; chunk_id < 3; ++chunk_id) {
+    const auto segment = t.get_chunk(chunk_id).get_segment(ColumnID{1});
+    EXPECT_NE(std::dynamic_pointer_cast<DictionarySegment<std::string>>(segment), nullptr);
+  }
+}
+
+TEST_F(StorageTableTest, CompressTableReportsMemorySaved) {
+  Table int_table{1000};
+  int_table.add_column("col_1", "int");
+  for (int i = 0; i < 2000; ++i) int_table.append({i % 10});
+
+  const auto statistics = int_table.compress({EncodingType::Dictionary});
+  ASSERT_EQ(statistics.size(), 2u);
+  for (const auto& chunk_statistics : statistics) {
+    EXPECT_GE(chunk_statistics.memory_usage_before, 1000 * sizeof(int));
+    EXPECT_LT(chunk_statistics.memory_usage_after, 1000u);
+  }
+}
+
+TEST_F(StorageTableTest, AutoCompression) {
+  t.append({1, "full"});
+  t.append({2, "full"});
+  t.enable_auto_compression(2);
+
+  for (int i = 0; i < 99; ++i) t.append({i % 7, "value_" + std::to_string(i % 13)});
+  t.wait_for_auto_compression();
+
+  // All full chunks are compressed, including the one that was full before auto compression was enabled
+  EXPECT_EQ(t.chunk_count(), 51u);
+  for (ChunkID chunk_id{0}; chunk_id < 50; ++chunk_id) {
+    const auto& chunk = t.get_chunk(chunk_id);
+    EXPECT_NE(std::dynamic_pointer_cast<DictionarySegment<int>>(chunk.get_segment(ColumnID{0})), nullptr);
+    EXPECT_NE(chunk.get_zone_map(ColumnID{0}), nullptr);
+  }
+  const auto string_segment =
+      std::dynamic_pointer_cast<DictionarySegment<std::string>>(t.get_chunk(ChunkID{49}).get_segment(ColumnID{1}));
+  ASSERT_NE(string_segment, nullptr);
+  EXPECT_EQ(string_segment->get(1), "value_" + std::to_string(97 % 13));
+
+  // The chunk that is still being filled stays uncompressed
+  EXPECT_NE(std::dynamic_pointer_cast<ValueSegment<int>>(t.get_chunk(ChunkID{50}).get_segment(ColumnID{0})), nullptr);
+  EXPECT_EQ(t.row_count(), 101u);
+
+  EXPECT_THROW(t.enable_auto_compression(), std::exception);
+  t.disable_auto_compression();
+  EXPECT_THROW(t.wait_for_auto_compression(), std::exception);
+}
+
+TEST_F(StorageTableTest, AutoCompressionReportsErrors) {
+  // Strings cannot be encoded using frame-of-reference
+  t.enable_auto_compression(1, EncodingType::FrameOfReference);
+  t.append({1, "a"});
+  t.append({2, "b"});
+  EXPECT_THROW(t.wait_for_auto_compression(), std::exception);
+
+  // The error is only reported once
+  EXPECT_NO_THROW(t.wait_for_auto_compression());
+  t.disable_auto_compression();
+}
+
+TEST_F(StorageTableTest, AppendRowsConcurrently) {
+  constexpr auto thread_count = 4;
+  constexpr auto rows_per_thread = 1000;
+  Table concurrent_table{100};
+  concurrent_table.add_column("col_1", "int");
+  concurrent_table.add_column("col_2", "string");
+  concurrent_table.enable_auto_compression(1);
+
+  std::vector<std::thread> threads;
+  for (int thread_id = 0; thread_id < thread_count; ++thread_id) {
+    threads.emplace_back([&, thread_id] {
+      // Batches of different sizes make the rows of one batch span multiple chunks
+      for (int row = 0; row < rows_per_thread;) {
+        std::vector<std::vector<AllTypeVariant>> rows;
+        for (const auto end = std::min(row + thread_id * 13 + 1, rows_per_thread); row < end; ++row) {
+          const auto value = thread_id * rows_per_thread + row;
+          rows.push_back({value, std::to_string(value)});
+        }
+        concurrent_table.append_rows(rows);
+      }
+    });
+  }
+
+  // The row count and the chunk count only grow while the rows are appended
+  auto previous_row_count = uint64_t{0};
+  auto previous_chunk_count = ChunkID{1};
+  while (previous_row_count < thread_count * rows_per_thread) {
+    const auto row_count = concurrent_table.row_count();
+    const auto chunk_count = concurrent_table.chunk_count();
+    EXPECT_GE(row_count, previous_row_count);
+    EXPECT_GE(chunk_count, previous_chunk_count);
+    previous_row_count = row_count;
+    previous_chunk_count = chunk_count;
+    std::this_thread::yield();
+  }
+  for (auto& thread : threads) thread.join();
+  concurrent_table.disable_auto_compression();
+
+  EXPECT_EQ(concurrent_table.row_count(), static_cast<uint64_t>(thread_count * rows_per_thread));
+  ASSERT_EQ(concurrent_table.chunk_count(), 41u);
+
+  // Every row is appended exactly once, the values of a row stay together, and the rows of each thread keep their order
+  std::vector<int> next_row_of_thread(thread_count, 0);
+  for (ChunkID chunk_id{0}; chunk_id < 40; ++chunk_id) {
+    const auto& chunk = concurrent_table.get_chunk(chunk_id);
+    ASSERT_EQ(chunk.size(), 100u);
+    EXPECT_NE(std::dynamic_pointer_cast<DictionarySegment<int>>(chunk.get_segment(ColumnID{0})), nullptr);
+    for (ChunkOffset offset{0}; offset < chunk.size(); ++offset) {
+      const auto value = type_cast<int>((*chunk.get_segment(ColumnID{0}))[offset]);
+      EXPECT_EQ(type_cast<std::string>((*chunk.get_segment(ColumnID{1}))[offset]), std::to_string(value));
+      EXPECT_EQ(value % rows_per_thread, next_row_of_thread[value / rows_per_thread]++);
+    }
+  }
+  EXPECT_EQ(next_row_of_thread, std::vector<int>(thread_count, rows_per_thread));
+}
+
+TEST_F(StorageTableTest, AppendRowsRejectsInvalidRows) {
+  t.append({1, "one"});
+  EXPECT_THROW(t.append_rows({{2, "two"}, {3}}), std::exception);
+  EXPECT_THROW(t.append_rows({{2, "two"}, {"three", 3}}), std::exception);
+  EXPECT_EQ(t.row_count(), 1u);
+
+  // The table is still usable afterwards
+  t.append_rows({{2, "two"}, {3, "three"}});
+  EXPECT_EQ(t.row_count(), 3u);
+  EXPECT_EQ(t.chunk_count(), 2u);
+}
+
+TEST_F(StorageTableTest, AppendAfterFailedAllocation) {
+  // Fails all allocations while `fail` is set
+  class FailingMemoryResource : public std::pmr::memory_resource {
+   public:
+    bool fail{false};
+
+   protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+      if (fail) throw std::bad_alloc{};
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+      std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+  };
+
+  // The segments of the first chunk allocate their values from the default memory resource at their creation
+  FailingMemoryResource memory_resource;
+  const auto default_memory_resource = std::pmr::set_default_resource(&memory_resource);
+  Table table{4};
+  table.add_column("col_1", "int");
+  table.add_column("col_2", "string");
+  std::pmr::set_default_resource(default_memory_resource);
+
+  table.append({1, "one"});
+  memory_resource.fail = true;
+  EXPECT_THROW(table.append_rows({{2, "two"}, {3, "three"}}), std::bad_alloc);
+  EXPECT_EQ(table.row_count(), 1u);
+
+  // The rows of the failed call were not reserved, so that the next rows follow the first one and fill the chunk
+  memory_resource.fail = false;
+  table.append_rows({{2, "two"}, {3, "three"}, {4, "four"}, {5, "five"}});
+  EXPECT_EQ(table.row_count(), 5u);
+  ASSERT_EQ(table.chunk_count(), 2u);
+  const auto& chunk = table.get_chunk(ChunkID{0});
+  ASSERT_EQ(chunk.size(), 4u);
+  const auto strings = std::vector<std::string>{"one", "two", "three", "four"};
+  for (ChunkOffset offset{0}; offset < 4; ++offset) {
+    EXPECT_EQ(type_cast<int>((*chunk.get_segment(ColumnID{0}))[offset]), static_cast<int>(offset + 1));
+    EXPECT_EQ(type_cast<std::string>((*chunk.get_segment(ColumnID{1}))[offset]), strings[offset]);
+  }
+  EXPECT_NE(chunk.get_zone_map(ColumnID{0}), nullptr);
+}
+
+TEST_F(StorageTableTest, AppendColumns) {
+  t.append({0, "zero"});
+  t.append_columns(std::vector<int>{1, 2, 3, 4}, std::vector<std::string>{"one", "two", "three", "four"});
+  t.append_columns(std::vector<int>{5}, StringHeap{"five"});
+
+  // The values are split at chunk boundaries
+  EXPECT_EQ(t.row_count(), 6u);
+  EXPECT_EQ(t.chunk_count(), 4u);
+  const auto strings = std::vector<std::string>{"zero", "one", "two", "three", "four", "five"};
+  for (ChunkID chunk_id{0}; chunk_id < 3; ++chunk_id) {
+    const auto& chunk = t.get_chunk(chunk_id);
+    ASSERT_EQ(chunk.size(), 2u);
+    for (ChunkOffset offset{0}; offset < 2; ++offset) {
+      EXPECT_EQ(type_cast<int>((*chunk.get_segment(ColumnID{0}))[offset]), static_cast<int>(chunk_id * 2 + offset));
+      EXPECT_EQ(type_cast<std::string>((*chunk.get_segment(ColumnID{1}))[offset]), strings[chunk_id * 2 + offset]);
+    }
+    EXPECT_NE(chunk.get_zone_map(ColumnID{0}), nullptr);
+  }
+
+  EXPECT_THROW(t.append_columns(std::vector<int>{6}), std::exception);
+  EXPECT_THROW(t.append_columns(std::vector<float>{6.0f}, std::vector<std::string>{"six"}), std::exception);
+  EXPECT_THROW(t.append_columns(std::vector<int>{6, 7}, std::vector<std::string>{"six"}), std::exception);
+  EXPECT_EQ(t.row_count(), 6u);
+}
+
+TEST_F(StorageTableTest, AppendColumnsMovesValuesIntoEmptyChunks) {
+  Table int_table{4};
+  int_table.add_column("col_1", "int");
+
+  auto values = std::pmr::vector<int>{1, 2, 3, 4};
+  const auto data = values.data();
+  int_table.append_columns(std::move(values));
+
+  const auto segment =
+      std::dynamic_pointer_cast<ValueSegment<int>>(int_table.get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  ASSERT_NE(segment, nullptr);
+  EXPECT_EQ(segment->values().data(), data);
+  EXPECT_EQ(segment->values(), (ValueVector<int>{1, 2, 3, 4}));
+}
+
+TEST_F(StorageTableTest, EstimateMemoryUsage) {
+  for (auto value = int32_t{0}; value < 10; ++value) t.append({value, std::string(100, 'x')});
+
+  auto chunk_bytes = size_t{0};
+  for (ChunkID chunk_id{0}; chunk_id < t.chunk_count(); ++chunk_id) {
+    chunk_bytes += t.get_chunk(chunk_id).estimate_memory_usage();
+  }
+  EXPECT_GT(t.estimate_memory_usage(), chunk_bytes);
+  EXPECT_GT(chunk_bytes, 10 * 100u);
+}
+
+TEST_F(StorageTableTest, EstimateMemoryUsageAfterCompression) {
+  auto table = Table{1000};
+  table.add_column("col_1", "string");
+  for (auto row = 0; row < 1000; ++row) table.append({std::string(100, 'x')});
+  const auto uncompressed_bytes = table.estimate_memory_usage();
+
+  // All strings are equal, so the dictionary holds the string once
+  table.compress(ChunkEncodingSpec{EncodingType::Dictionary});
+  EXPECT_LT(table.estimate_memory_usage() * 10, uncompressed_bytes);
+}
+
 TEST_F(StorageTableTest, EmplaceChunk) {
   EXPECT_EQ(t.chunk_count(), 1u);
   Chunk c;
@@ -117,4 +491,42 @@ TEST_F(StorageTableTest, EmplaceChunk) {
   EXPECT_EQ(t.chunk_count(), 2u);
 }
 
+TEST_F(StorageTableTest, AppendAfterLastChunkIsEncoded) {
+  // The last chunk is not full, but its segments are encoded, so the rows go to a new chunk
+  t.append({1, "Hello"});
+  t.compress_chunk(ChunkID{0});
+  t.append({2, "World"});
+  EXPECT_EQ(t.chunk_count(), 2u);
+  EXPECT_EQ(t.get_chunk(ChunkID{0}).size(), 1u);
+  EXPECT_EQ(t.get_chunk(ChunkID{1}).size(), 1u);
+
+  const auto make_chunk = [](const bool encode_strings) {
+    auto int_segment = std::make_shared<ValueSegment<int>>();
+    int_segment->append(3);
+    auto string_segment = std::make_shared<ValueSegment<std::string>>();
+    string_segment->append("encoded");
+    Chunk chunk;
+    chunk.add_segment(std::make_shared<DictionarySegment<int>>(int_segment));
+    if (encode_strings) {
+      chunk.add_segment(std::make_shared<DictionarySegment<std::string>>(string_segment));
+    } else {
+      chunk.add_segment(string_segment);
+    }
+    return chunk;
+  };
+
+  // Chunks emplaced with encoded segments, e.g., by read_binary_table, are not appended to either
+  t.emplace_chunk(make_chunk(true));
+  t.append({4, "!"});
+  EXPECT_EQ(t.chunk_count(), 4u);
+  EXPECT_EQ(t.get_chunk(ChunkID{2}).size(), 1u);
+  EXPECT_EQ(t.get_chunk(ChunkID{3}).size(), 1u);
+  EXPECT_EQ(t.row_count(), 4u);
+
+  // Chunks that mix encoded segments and ValueSegments cannot be appended to
+  t.emplace_chunk(make_chunk(false));
+  EXPECT_THROW(t.append({5, "?"}), std::logic_error);
+  EXPECT_EQ(t.row_count(), 5u);
+}
+
 }  // namespace opossum
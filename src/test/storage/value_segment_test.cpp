@@ -47,4 +47,33 @@ TEST_F(StorageValueSegmentTest, AddValueOfDifferentType) {
   EXPECT_THROW(double_value_segment.append("Hi"), std::exception);
 }
 
+TEST_F(StorageValueSegmentTest, AppendValues) {
+  int_value_segment.append(1);
+  int_value_segment.append_values(ValueVector<int>{2, 3, 4, 5}, 1, 3);
+  EXPECT_EQ(int_value_segment.values(), (ValueVector<int>{1, 3, 4}));
+
+  string_value_segment.append("Hello");
+  string_value_segment.append_values(StringHeap{"a", "bc", "", "def"}, 1, 4);
+  EXPECT_EQ(string_value_segment.values(), (StringHeap{"Hello", "bc", "", "def"}));
+}
+
+TEST_F(StorageValueSegmentTest, MemoryResource) {
+  EXPECT_EQ(int_value_segment.memory_resource(), std::pmr::get_default_resource());
+
+  std::pmr::monotonic_buffer_resource memory_resource;
+  ValueSegment<int> int_segment{&memory_resource};
+  ValueSegment<std::string> string_segment{&memory_resource};
+  int_segment.append(1);
+  string_segment.append("Hello");
+  EXPECT_EQ(int_segment.memory_resource(), &memory_resource);
+  EXPECT_EQ(string_segment.memory_resource(), &memory_resource);
+  EXPECT_EQ(string_segment.values().get_allocator().resource(), &memory_resource);
+
+  // The released values keep their memory resource, and so does the segment
+  const auto values = int_segment.release_values();
+  EXPECT_EQ(values.get_allocator().resource(), &memory_resource);
+  EXPECT_EQ(int_segment.memory_resource(), &memory_resource);
+  EXPECT_EQ(values, ValueVector<int>{1});
+}
+
 }  // namespace opossum
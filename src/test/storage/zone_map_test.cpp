@@ -0,0 +1,76 @@
+#include <memory>
+#include <string>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/dictionary_segment.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/zone_map.hpp"
+
+namespace opossum {
+
+class StorageZoneMapTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    for (const auto value : {7, 3, 9, 5}) vc_int->append(value);
+  }
+
+  std::shared_ptr<ValueSegment<int>> vc_int = std::make_shared<ValueSegment<int>>();
+};
+
+TEST_F(StorageZoneMapTest, BuildFromSegments) {
+  const auto check = [](const ZoneMap<int>& zone_map) {
+    EXPECT_EQ(zone_map.min(), 3);
+    EXPECT_EQ(zone_map.max(), 9);
+  };
+  check(ZoneMap<int>{vc_int});
+  check(ZoneMap<int>{std::make_shared<DictionarySegment<int>>(vc_int)});
+  check(ZoneMap<int>{std::make_shared<RunLengthSegment<int>>(vc_int)});
+
+  auto vc_str = std::make_shared<ValueSegment<std::string>>();
+  vc_str->append("Hasso");
+  vc_str->append("Bill");
+  const auto string_zone_map = ZoneMap<std::string>{vc_str};
+  EXPECT_EQ(string_zone_map.min(), "Bill");
+  EXPECT_EQ(string_zone_map.max(), "Hasso");
+}
+
+TEST_F(StorageZoneMapTest, CanMatch) {
+  const auto zone_map = ZoneMap<int>{3, 9};
+
+  EXPECT_FALSE(zone_map.can_match(ScanType::OpEquals, 2));
+  EXPECT_TRUE(zone_map.can_match(ScanType::OpEquals, 3));
+  EXPECT_TRUE(zone_map.can_match(ScanType::OpEquals, 4));
+  EXPECT_FALSE(zone_map.can_match(ScanType::OpEquals, 10));
+  EXPECT_TRUE(zone_map.can_match(ScanType::OpNotEquals, 3));
+  EXPECT_FALSE(ZoneMap<int>(4, 4).can_match(ScanType::OpNotEquals, 4));
+  EXPECT_FALSE(zone_map.can_match(ScanType::OpLessThan, 3));
+  EXPECT_TRUE(zone_map.can_match(ScanType::OpLessThan, 4));
+  EXPECT_FALSE(zone_map.can_match(ScanType::OpLessThanEquals, 2));
+  EXPECT_TRUE(zone_map.can_match(ScanType::OpLessThanEquals, 3));
+  EXPECT_FALSE(zone_map.can_match(ScanType::OpGreaterThan, 9));
+  EXPECT_TRUE(zone_map.can_match(ScanType::OpGreaterThan, 8));
+  EXPECT_FALSE(zone_map.can_match(ScanType::OpGreaterThanEquals, 10));
+  EXPECT_TRUE(zone_map.can_match(ScanType::OpGreaterThanEquals, 9));
+}
+
+TEST_F(StorageZoneMapTest, MatchesAll) {
+  const auto zone_map = ZoneMap<int>{3, 9};
+
+  EXPECT_FALSE(zone_map.matches_all(ScanType::OpEquals, 3));
+  EXPECT_TRUE(ZoneMap<int>(4, 4).matches_all(ScanType::OpEquals, 4));
+  EXPECT_FALSE(zone_map.matches_all(ScanType::OpNotEquals, 9));
+  EXPECT_TRUE(zone_map.matches_all(ScanType::OpNotEquals, 10));
+  EXPECT_FALSE(zone_map.matches_all(ScanType::OpLessThan, 9));
+  EXPECT_TRUE(zone_map.matches_all(ScanType::OpLessThan, 10));
+  EXPECT_FALSE(zone_map.matches_all(ScanType::OpLessThanEquals, 8));
+  EXPECT_TRUE(zone_map.matches_all(ScanType::OpLessThanEquals, 9));
+  EXPECT_FALSE(zone_map.matches_all(ScanType::OpGreaterThan, 3));
+  EXPECT_TRUE(zone_map.matches_all(ScanType::OpGreaterThan, 2));
+  EXPECT_FALSE(zone_map.matches_all(ScanType::OpGreaterThanEquals, 4));
+  EXPECT_TRUE(zone_map.matches_all(ScanType::OpGreaterThanEquals, 3));
+}
+
+}  // namespace opossum
@@ -0,0 +1,140 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/bit_packed_attribute_vector.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/zone_map.hpp"
+#include "utils/binary_table.hpp"
+#include "utils/mapped_file.hpp"
+
+namespace opossum {
+
+class BinaryTableTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(100);
+    _table->add_column("a", "int");
+    _table->add_column("b", "string");
+    _table->add_column("c", "long");
+    _table->add_column("d", "double");
+    for (int i = 0; i < 350; ++i) {
+      _table->append({i % 60 - 30, "value_" + std::to_string(i % 40), int64_t{1} << 40 | i, i / 3 * 0.5});
+    }
+
+    // Each chunk uses different encodings, the last one is not compressed
+    _table->compress_chunk(ChunkID{0}, EncodingType::Dictionary);
+    _table->compress_chunk(ChunkID{1}, {EncodingType::RunLength, EncodingType::FrontCodedDictionary,
+                                        EncodingType::FrameOfReference, EncodingType::RunLength});
+    _table->compress_chunk(ChunkID{2}, {EncodingType::FrameOfReference, EncodingType::RunLength,
+                                        EncodingType::Dictionary, EncodingType::Dictionary});
+  }
+
+  void TearDown() override { std::filesystem::remove(_file_name); }
+
+  std::shared_ptr<Table> _table;
+  const std::string _file_name = std::filesystem::temp_directory_path() / "opossum_binary_table_test.bin";
+};
+
+TEST_F(BinaryTableTest, RoundTrip) {
+  write_binary_table(*_table, _file_name);
+  const auto table = read_binary_table(_file_name);
+
+  EXPECT_EQ(table->chunk_size(), 100u);
+  EXPECT_EQ(table->chunk_count(), 4u);
+  EXPECT_EQ(table->column_name(ColumnID{1}), "b");
+  EXPECT_EQ(table->column_type(ColumnID{3}), "double");
+  EXPECT_TABLE_EQ(table, _table, true);
+
+  // Segments keep their encoding
+  EXPECT_NE(std::dynamic_pointer_cast<DictionarySegment<int>>(table->get_chunk(ChunkID{0}).get_segment(ColumnID{0})),
+            nullptr);
+  const auto front_coded_segment = std::dynamic_pointer_cast<DictionarySegment<std::string>>(
+      table->get_chunk(ChunkID{1}).get_segment(ColumnID{1}));
+  ASSERT_NE(front_coded_segment, nullptr);
+  EXPECT_NE(front_coded_segment->front_coded_dictionary(), nullptr);
+  EXPECT_NE(
+      std::dynamic_pointer_cast<RunLengthSegment<int>>(table->get_chunk(ChunkID{1}).get_segment(ColumnID{0})),
+      nullptr);
+  EXPECT_NE(std::dynamic_pointer_cast<FrameOfReferenceSegment<int>>(
+                table->get_chunk(ChunkID{2}).get_segment(ColumnID{0})),
+            nullptr);
+  EXPECT_NE(
+      std::dynamic_pointer_cast<ValueSegment<std::string>>(table->get_chunk(ChunkID{3}).get_segment(ColumnID{1})),
+      nullptr);
+
+  // Zone maps are restored
+  const auto zone_map =
+      std::dynamic_pointer_cast<const ZoneMap<std::string>>(table->get_chunk(ChunkID{0}).get_zone_map(ColumnID{1}));
+  ASSERT_NE(zone_map, nullptr);
+  EXPECT_EQ(zone_map->min(), "value_0");
+  EXPECT_EQ(zone_map->max(), "value_9");
+  EXPECT_EQ(table->get_chunk(ChunkID{3}).get_zone_map(ColumnID{0}), nullptr);
+
+  // Rows can be appended to the last chunk
+  table->append({1, "new", int64_t{2}, 3.0});
+  EXPECT_EQ(table->row_count(), 351u);
+}
+
+TEST_F(BinaryTableTest, ReferencesMappedFile) {
+  write_binary_table(*_table, _file_name);
+  auto file = std::make_shared<const MappedFile>(_file_name);
+  const auto table = read_binary_table(file);
+
+  const auto segment =
+      std::dynamic_pointer_cast<DictionarySegment<int>>(table->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  ASSERT_NE(segment, nullptr);
+  // 60 unique values need six bits per value id
+  const auto attribute_vector =
+      std::dynamic_pointer_cast<const BitPackedAttributeVector>(segment->attribute_vector());
+  ASSERT_NE(attribute_vector, nullptr);
+  const auto* const data = reinterpret_cast<const char*>(attribute_vector->words());
+  EXPECT_GE(data, file->data());
+  EXPECT_LT(data, file->data() + file->size());
+
+  // Segments keep the file mapped
+  const auto weak_file = std::weak_ptr<const MappedFile>{file};
+  file.reset();
+  EXPECT_FALSE(weak_file.expired());
+  EXPECT_EQ(segment->get(99), 9);
+}
+
+TEST_F(BinaryTableTest, ImportedChunksAreNotCompressedAgain) {
+  write_binary_table(*_table, _file_name);
+  const auto table = read_binary_table(_file_name);
+
+  const auto segment = table->get_chunk(ChunkID{1}).get_segment(ColumnID{0});
+  table->compress_chunk(ChunkID{1});
+  EXPECT_EQ(table->get_chunk(ChunkID{1}).get_segment(ColumnID{0}), segment);
+}
+
+TEST_F(BinaryTableTest, RejectsInvalidFiles) {
+  EXPECT_THROW(read_binary_table(_file_name), std::logic_error);
+
+  auto table = Table{2};
+  table.add_column("a", "int");
+  table.append({1});
+  table.append({2});
+  write_binary_table(table, _file_name);
+  std::filesystem::resize_file(_file_name, std::filesystem::file_size(_file_name) - 1);
+  EXPECT_THROW(read_binary_table(_file_name), std::logic_error);
+
+  // The flag whether the first chunk has zone maps follows the header and the column definition at offset 42
+  write_binary_table(table, _file_name);
+  {
+    auto file = std::fstream{_file_name, std::ios::binary | std::ios::in | std::ios::out};
+    file.seekp(42);
+    file.put(2);
+  }
+  EXPECT_THROW(read_binary_table(_file_name), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,176 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/dictionary_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/zone_map.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class LoadTableTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _expected_table = std::make_shared<Table>(100);
+    _expected_table->add_column("a", "int");
+    _expected_table->add_column("b", "string");
+    _expected_table->add_column("c", "double");
+    _expected_table->add_column("d", "long");
+
+    auto file = std::ofstream{_file_name};
+    file << "a|b|c|d\nint|string|double|long\n";
+    for (int i = 0; i < 1050; ++i) {
+      const auto string = "value " + std::to_string(i % 17);
+      _expected_table->append({i, string, i * 0.25, int64_t{i} << 33});
+      file << i << '|' << string << '|' << i * 0.25 << '|' << (int64_t{i} << 33) << '\n';
+    }
+  }
+
+  void TearDown() override { std::filesystem::remove(_file_name); }
+
+  void _write_file(const std::string& content) {
+    auto file = std::ofstream{_file_name};
+    file << content;
+  }
+
+  std::shared_ptr<Table> _expected_table;
+  const std::string _file_name = std::filesystem::temp_directory_path() / "opossum_load_table_test.tbl";
+};
+
+TEST_F(LoadTableTest, LoadsInParallel) {
+  for (const auto thread_count : {size_t{1}, size_t{4}}) {
+    for (const auto block_size : {size_t{7}, size_t{4096}, size_t{1} << 22}) {
+      auto options = LoadTableOptions{};
+      options.thread_count = thread_count;
+      options.block_size = block_size;
+      const auto table = load_table(_file_name, 100, options);
+      EXPECT_EQ(table->chunk_count(), 11u);
+      EXPECT_EQ(table->row_count(), 1050u);
+      EXPECT_TABLE_EQ(table, _expected_table, true);
+    }
+  }
+}
+
+TEST_F(LoadTableTest, LoadsSingleChunkInParallel) {
+  // With the default chunk size, all rows end up in one chunk, but the blocks are still parsed by several threads
+  for (const auto block_size : {size_t{7}, size_t{4096}}) {
+    auto options = LoadTableOptions{};
+    options.thread_count = 4;
+    options.block_size = block_size;
+    const auto table = load_table(_file_name, 0, options);
+    EXPECT_EQ(table->chunk_count(), 1u);
+    EXPECT_TABLE_EQ(table, _expected_table, true);
+
+    const auto segment = std::dynamic_pointer_cast<const ValueSegment<std::string>>(
+        table->get_chunk(ChunkID{0}).get_segment(ColumnID{1}));
+    ASSERT_NE(segment, nullptr);
+    EXPECT_EQ(segment->size(), 1050u);
+  }
+}
+
+TEST_F(LoadTableTest, BuildsZoneMapsOfFullChunks) {
+  const auto table = load_table(_file_name, 100);
+  const auto zone_map =
+      std::dynamic_pointer_cast<const ZoneMap<int>>(table->get_chunk(ChunkID{3}).get_zone_map(ColumnID{0}));
+  ASSERT_NE(zone_map, nullptr);
+  EXPECT_EQ(zone_map->min(), 300);
+  EXPECT_EQ(zone_map->max(), 399);
+  EXPECT_EQ(table->get_chunk(ChunkID{10}).get_zone_map(ColumnID{0}), nullptr);
+
+  // Rows are appended to the last chunk
+  table->append({1, "new", 1.0, int64_t{1}});
+  EXPECT_EQ(table->chunk_count(), 11u);
+  EXPECT_EQ(table->get_chunk(ChunkID{10}).size(), 51u);
+}
+
+TEST_F(LoadTableTest, EncodesFullChunks) {
+  auto options = LoadTableOptions{};
+  options.encoding_type = EncodingType::Dictionary;
+  const auto table = load_table(_file_name, 100, options);
+  EXPECT_TABLE_EQ(table, _expected_table, true);
+
+  const auto segment = table->get_chunk(ChunkID{9}).get_segment(ColumnID{1});
+  EXPECT_NE(std::dynamic_pointer_cast<DictionarySegment<std::string>>(segment), nullptr);
+  EXPECT_NE(table->get_chunk(ChunkID{9}).get_zone_map(ColumnID{1}), nullptr);
+  const auto last_segment = table->get_chunk(ChunkID{10}).get_segment(ColumnID{1});
+  EXPECT_NE(std::dynamic_pointer_cast<ValueSegment<std::string>>(last_segment), nullptr);
+
+  // Encoded chunks are not compressed again
+  table->compress_chunk(ChunkID{9});
+  EXPECT_EQ(table->get_chunk(ChunkID{9}).get_segment(ColumnID{1}), segment);
+}
+
+TEST_F(LoadTableTest, LoadsCsv) {
+  // Windows line breaks and a missing line break at the end of the file are accepted
+  _write_file("a,b\r\nint,float\r\n1,2.5\r\n3.0,-4");
+  auto options = LoadTableOptions{};
+  options.delimiter = ',';
+  const auto table = load_table(_file_name, 10, options);
+
+  auto expected_table = Table{10};
+  expected_table.add_column("a", "int");
+  expected_table.add_column("b", "float");
+  expected_table.append({1, 2.5f});
+  expected_table.append({3, -4.0f});
+  EXPECT_TABLE_EQ(*table, expected_table, true);
+}
+
+TEST_F(LoadTableTest, IgnoresTrailingDelimiters) {
+  // Lines written by dbgen end with a delimiter. Only one is ignored, so that the last value can be empty.
+  _write_file("a|b|\nint|string|\n1|x|\n2||\n3|y\n");
+  const auto table = load_table(_file_name, 10);
+
+  auto expected_table = Table{10};
+  expected_table.add_column("a", "int");
+  expected_table.add_column("b", "string");
+  expected_table.append({1, "x"});
+  expected_table.append({2, ""});
+  expected_table.append({3, "y"});
+  EXPECT_TABLE_EQ(*table, expected_table, true);
+}
+
+TEST_F(LoadTableTest, ParsesFloatingPointNumbers) {
+  // The last value is longer than the buffer used for parsing
+  const auto long_value = "0." + std::string(80, '0') + "1e82";
+  _write_file("a|b\nfloat|double\n1e3|-0.125\n.5|" + long_value + "\n");
+  const auto table = load_table(_file_name, 10);
+
+  auto expected_table = Table{10};
+  expected_table.add_column("a", "float");
+  expected_table.add_column("b", "double");
+  expected_table.append({1000.0f, -0.125});
+  expected_table.append({0.5f, 10.0});
+  EXPECT_TABLE_EQ(*table, expected_table, true);
+
+  // Values are rejected like by std::from_chars, which does not skip whitespace or accept hexadecimal numbers
+  for (const auto* const value : {" 1.5", "+1.5", "0x1p3", "1.5 ", "1e999", ""}) {
+    _write_file(std::string("a\ndouble\n") + value + "\n");
+    EXPECT_THROW(load_table(_file_name, 10), std::logic_error) << value;
+  }
+}
+
+TEST_F(LoadTableTest, LoadsEmptyTable) {
+  _write_file("a|b\nint|string\n");
+  const auto table = load_table(_file_name, 10);
+  EXPECT_EQ(table->column_count(), 2u);
+  EXPECT_EQ(table->row_count(), 0u);
+  EXPECT_EQ(table->chunk_count(), 1u);
+}
+
+TEST_F(LoadTableTest, RejectsInvalidRows) {
+  _write_file("a|b\nint|string\n1|one\n2\n");
+  EXPECT_THROW(load_table(_file_name, 10), std::logic_error);
+
+  _write_file("a|b\nint|string\n1|one\ntwo|two\n");
+  EXPECT_THROW(load_table(_file_name, 10), std::logic_error);
+
+  EXPECT_THROW(load_table("src/test/tables/does_not_exist.tbl", 10), std::logic_error);
+}
+
+}  // namespace opossum
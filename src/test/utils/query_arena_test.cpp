@@ -0,0 +1,61 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "utils/query_arena.hpp"
+
+namespace opossum {
+
+class QueryArenaTest : public BaseTest {};
+
+TEST_F(QueryArenaTest, AllocatesFromArena) {
+  auto arena = std::make_shared<QueryArena>(1024);
+  auto pos_list = std::pmr::vector<RowID>{arena.get()};
+  pos_list.resize(100, RowID{ChunkID{0}, 1});
+  EXPECT_GE(arena->allocated_bytes(), 100 * sizeof(RowID));
+  EXPECT_EQ(pos_list[99].chunk_offset, 1u);
+
+  // Memory is only released once the arena is destroyed
+  const auto allocated_bytes = arena->allocated_bytes();
+  pos_list = std::pmr::vector<RowID>{arena.get()};
+  EXPECT_EQ(arena->allocated_bytes(), allocated_bytes);
+}
+
+TEST_F(QueryArenaTest, MakeSharedKeepsArenaAlive) {
+  auto arena = std::make_shared<QueryArena>();
+  const auto pos_list = arena->make_shared<PosList>(3, RowID{ChunkID{1}, 2});
+  EXPECT_EQ(pos_list->get_allocator().resource(), arena.get());
+
+  const auto weak_arena = std::weak_ptr<QueryArena>{arena};
+  arena.reset();
+  EXPECT_FALSE(weak_arena.expired());
+  EXPECT_EQ((*pos_list)[2], (RowID{ChunkID{1}, 2}));
+}
+
+TEST_F(QueryArenaTest, ConcurrentAllocations) {
+  auto arena = std::make_shared<QueryArena>(64);
+  auto pos_lists = std::vector<std::shared_ptr<PosList>>(4);
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = size_t{0}; thread_id < pos_lists.size(); ++thread_id) {
+    threads.emplace_back([&, thread_id] {
+      pos_lists[thread_id] = arena->make_shared<PosList>();
+      for (ChunkOffset offset{0}; offset < 10'000; ++offset) {
+        pos_lists[thread_id]->emplace_back(RowID{ChunkID{static_cast<uint32_t>(thread_id)}, offset});
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  for (auto thread_id = size_t{0}; thread_id < pos_lists.size(); ++thread_id) {
+    ASSERT_EQ(pos_lists[thread_id]->size(), 10'000u);
+    for (ChunkOffset offset{0}; offset < 10'000; ++offset) {
+      ASSERT_EQ((*pos_lists[thread_id])[offset], (RowID{ChunkID{static_cast<uint32_t>(thread_id)}, offset}));
+    }
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/dictionary_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/table_generator.hpp"
+
+namespace opossum {
+
+class TableGeneratorTest : public BaseTest {
+ protected:
+  static ColumnSpecification _column(const std::string& name, const std::string& type,
+                                     const ValueDistribution distribution, const uint64_t distinct_value_count) {
+    auto column = ColumnSpecification{};
+    column.name = name;
+    column.type = type;
+    column.distribution = distribution;
+    column.distinct_value_count = distinct_value_count;
+    return column;
+  }
+
+  template <typename T>
+  static std::vector<T> _values(const Table& table, const ColumnID column_id) {
+    std::vector<T> values;
+    for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& segment = *table.get_chunk(chunk_id).get_segment(column_id);
+      for (size_t offset = 0; offset < segment.size(); ++offset) values.emplace_back(type_cast<T>(segment[offset]));
+    }
+    return values;
+  }
+};
+
+TEST_F(TableGeneratorTest, GeneratesSameTableWithAnyThreadCount) {
+  const auto columns = std::vector<ColumnSpecification>{
+      _column("a", "int", ValueDistribution::Uniform, 100), _column("b", "long", ValueDistribution::Zipf, 100),
+      _column("c", "float", ValueDistribution::Sorted, 10),
+      _column("d", "string", ValueDistribution::ClusteredRuns, 5)};
+  auto options = TableGeneratorOptions{};
+  options.chunk_size = 100;
+  options.thread_count = 1;
+  const auto table = generate_table(columns, 1050, options);
+  EXPECT_EQ(table->row_count(), 1050u);
+  EXPECT_EQ(table->chunk_count(), 11u);
+  EXPECT_EQ(table->column_names(), (std::vector<std::string>{"a", "b", "c", "d"}));
+  EXPECT_EQ(table->column_type(ColumnID{3}), "string");
+
+  options.thread_count = 4;
+  EXPECT_TABLE_EQ(generate_table(columns, 1050, options), table, true);
+
+  options.seed = 43;
+  EXPECT_NE(_values<int32_t>(*generate_table(columns, 1050, options), ColumnID{0}),
+            _values<int32_t>(*table, ColumnID{0}));
+}
+
+TEST_F(TableGeneratorTest, Distributions) {
+  auto runs = _column("runs", "int", ValueDistribution::ClusteredRuns, 1000);
+  runs.run_length = 8;
+  auto strings = _column("strings", "string", ValueDistribution::Sorted, 5);
+  strings.string_length = 3;
+  const auto columns = std::vector<ColumnSpecification>{
+      _column("uniform", "int", ValueDistribution::Uniform, 10), _column("zipf", "int", ValueDistribution::Zipf, 10),
+      _column("key", "int", ValueDistribution::Sorted, 1000), _column("sorted", "int", ValueDistribution::Sorted, 3),
+      runs, strings};
+  auto options = TableGeneratorOptions{};
+  options.chunk_size = 64;
+  const auto table = generate_table(columns, 1000, options);
+
+  auto uniform_counts = std::map<int32_t, size_t>{};
+  for (const auto value : _values<int32_t>(*table, ColumnID{0})) ++uniform_counts[value];
+  EXPECT_EQ(uniform_counts.size(), 10u);
+  EXPECT_EQ(uniform_counts.begin()->first, 0);
+  EXPECT_EQ(uniform_counts.rbegin()->first, 9);
+
+  // With a skew of 1, value 0 is twice as likely as value 1 and accounts for a third of the rows
+  auto zipf_counts = std::map<int32_t, size_t>{};
+  for (const auto value : _values<int32_t>(*table, ColumnID{1})) ++zipf_counts[value];
+  EXPECT_GT(zipf_counts[0], 300u);
+  EXPECT_GT(zipf_counts[0], zipf_counts[1]);
+  EXPECT_GT(zipf_counts[1], zipf_counts[9]);
+
+  const auto keys = _values<int32_t>(*table, ColumnID{2});
+  for (size_t row = 0; row < keys.size(); ++row) EXPECT_EQ(keys[row], static_cast<int32_t>(row));
+
+  // The first value gets the remaining row
+  const auto sorted = _values<int32_t>(*table, ColumnID{3});
+  EXPECT_EQ(std::count(sorted.begin(), sorted.end(), 0), 334);
+  EXPECT_EQ(std::count(sorted.begin(), sorted.end(), 2), 333);
+  EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+
+  // Runs span chunks
+  const auto run_values = _values<int32_t>(*table, ColumnID{4});
+  for (size_t row = 0; row < run_values.size(); ++row) EXPECT_EQ(run_values[row], run_values[row / 8 * 8]);
+  EXPECT_GT(std::set<int32_t>(run_values.begin(), run_values.end()).size(), 100u);
+
+  const auto string_values = _values<std::string>(*table, ColumnID{5});
+  EXPECT_EQ(string_values.front(), "000");
+  EXPECT_EQ(string_values.back(), "004");
+}
+
+TEST_F(TableGeneratorTest, FinishesFullChunks) {
+  auto options = TableGeneratorOptions{};
+  options.chunk_size = 100;
+  options.encoding_type = EncodingType::Dictionary;
+  const auto table = generate_table({_column("a", "string", ValueDistribution::Uniform, 20)}, 250, options);
+  EXPECT_EQ(table->chunk_count(), 3u);
+  const auto& full_chunk = table->get_chunk(ChunkID{1});
+  EXPECT_NE(std::dynamic_pointer_cast<const DictionarySegment<std::string>>(full_chunk.get_segment(ColumnID{0})),
+            nullptr);
+  EXPECT_NE(full_chunk.get_zone_map(ColumnID{0}), nullptr);
+
+  // The last chunk can be appended to
+  const auto& last_chunk = table->get_chunk(ChunkID{2});
+  EXPECT_NE(std::dynamic_pointer_cast<const ValueSegment<std::string>>(last_chunk.get_segment(ColumnID{0})), nullptr);
+  table->append({"new"});
+  EXPECT_EQ(table->chunk_count(), 3u);
+  EXPECT_EQ(table->row_count(), 251u);
+
+  EXPECT_EQ(generate_table({_column("a", "int", ValueDistribution::Uniform, 20)}, 0, options)->row_count(), 0u);
+}
+
+TEST_F(TableGeneratorTest, RejectsInvalidColumns) {
+  EXPECT_THROW(generate_table({_column("a", "int", ValueDistribution::Uniform, 0)}, 10), std::logic_error);
+  EXPECT_THROW(generate_table({_column("a", "int", ValueDistribution::Uniform, uint64_t{1} << 40)}, 10),
+               std::logic_error);
+  EXPECT_THROW(generate_table({_column("a", "char", ValueDistribution::Uniform, 10)}, 10), std::logic_error);
+}
+
+TEST_F(TableGeneratorTest, GeneratesTpchTables) {
+  auto options = TableGeneratorOptions{};
+  options.chunk_size = 10'000;
+  generate_tpch_tables(0.01, options);
+
+  auto& storage_manager = StorageManager::get();
+  EXPECT_EQ(storage_manager.table_names(), (std::vector<std::string>{"customer", "lineitem", "nation", "orders", "part",
+                                                                      "partsupp", "region", "supplier"}));
+  EXPECT_EQ(storage_manager.get_table("region")->row_count(), 5u);
+  EXPECT_EQ(storage_manager.get_table("nation")->row_count(), 25u);
+  EXPECT_EQ(storage_manager.get_table("supplier")->row_count(), 100u);
+  EXPECT_EQ(storage_manager.get_table("orders")->row_count(), 15'000u);
+
+  // Each order has four line items
+  const auto lineitem = storage_manager.get_table("lineitem");
+  EXPECT_EQ(lineitem->row_count(), 60'000u);
+  EXPECT_EQ(lineitem->chunk_count(), 6u);
+  const auto order_keys = _values<int32_t>(*lineitem, lineitem->column_id_by_name("l_orderkey"));
+  EXPECT_EQ(order_keys[3], 0);
+  EXPECT_EQ(order_keys[4], 1);
+  EXPECT_EQ(order_keys.back(), 14'999);
+
+  EXPECT_THROW(tpch_table_specifications(0.0), std::logic_error);
+}
+
+}  // namespace opossum